@@ -19,4 +19,7 @@ set(CMAKE_CXX_COMPILER /opt/wasi-sdk/bin/clang++)
 
 add_definitions(-DCATCH_CONFIG_NO_POSIX_SIGNALS)
 
+# WASI has no threads
+set(SILKWORM_CORE_THREADS OFF CACHE BOOL "" FORCE)
+
 include(${CMAKE_CURRENT_LIST_DIR}/toolchain.cmake)
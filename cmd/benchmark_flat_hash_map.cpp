@@ -0,0 +1,71 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <silkworm/common/base.hpp>
+#include <silkworm/common/flat_hash_map.hpp>
+#include <unordered_map>
+
+using namespace silkworm;
+
+// Compares FlatHashMap with std::unordered_map (the former MemoryBuffer backend) on address keys.
+// Arg: number of entries in map
+
+static evmc::address make_address(uint64_t i) {
+    evmc::address address{};
+    const uint64_t x{i * 0x9E3779B97F4A7C15ull};
+    std::memcpy(&address.bytes[kAddressLength - sizeof(x)], &x, sizeof(x));
+    return address;
+}
+
+template <class Map>
+static void lookups(benchmark::State& state) {
+    const auto n{static_cast<uint64_t>(state.range(0))};
+    Map map;
+    for (uint64_t i{0}; i < n; ++i) {
+        map[make_address(i)] = i;
+    }
+    uint64_t i{0};
+    for (auto _ : state) {
+        auto it{map.find(make_address(i++ % (2 * n)))};  // Half hits, half misses
+        benchmark::DoNotOptimize(it == map.end() ? 0 : it->second);
+    }
+}
+
+template <class Map>
+static void inserts(benchmark::State& state) {
+    const auto n{static_cast<uint64_t>(state.range(0))};
+    for (auto _ : state) {
+        Map map;
+        for (uint64_t i{0}; i < n; ++i) {
+            map[make_address(i)] = i;
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using Flat = FlatHashMap<evmc::address, uint64_t>;
+using Std = std::unordered_map<evmc::address, uint64_t>;
+
+BENCHMARK_TEMPLATE(lookups, Flat)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(lookups, Std)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(inserts, Flat)->Arg(1'000)->Arg(100'000);
+BENCHMARK_TEMPLATE(inserts, Std)->Arg(1'000)->Arg(100'000);
+
+BENCHMARK_MAIN();
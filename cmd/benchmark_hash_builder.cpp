@@ -0,0 +1,81 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+#include <vector>
+
+// Counts heap allocations so that the benchmarks can report them.
+// Kept out of line so that the compiler doesn't pair up malloc & free across them.
+static std::atomic<uint64_t> allocations{0};
+
+[[gnu::noinline]] void* operator new(size_t size) {
+    ++allocations;
+    if (void* p{std::malloc(size)}) {
+        return p;
+    }
+    std::abort();
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace silkworm;
+
+static constexpr size_t kNumLeaves{10'000};
+
+// Sorted hashed keys with account-sized values
+static std::vector<std::pair<evmc::bytes32, Bytes>> make_leaves() {
+    std::vector<std::pair<evmc::bytes32, Bytes>> leaves(kNumLeaves);
+    for (uint64_t i{0}; i < kNumLeaves; ++i) {
+        leaves[i].first = to_bytes32(full_view(keccak256(ByteView{reinterpret_cast<uint8_t*>(&i), sizeof(i)}).bytes));
+        rlp::encode(leaves[i].second, to_bytes32(full_view(leaves[i].first)));
+        leaves[i].second.resize(70);
+    }
+    std::sort(leaves.begin(), leaves.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return leaves;
+}
+
+static void hash_builder_10k_leaves(benchmark::State& state) {
+    const auto leaves{make_leaves()};
+    uint64_t allocated{0};
+    for (auto _ : state) {
+        trie::HashBuilder hb;
+        // Warm up the builder's buffers before measuring steady-state allocations
+        hb.add(full_view(leaves[0].first), leaves[0].second);
+        const uint64_t before{allocations};
+        for (size_t i{1}; i < leaves.size(); ++i) {
+            hb.add(full_view(leaves[i].first), leaves[i].second);
+        }
+        allocated += allocations - before;
+        benchmark::DoNotOptimize(hb.root_hash());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumLeaves);
+    state.counters["allocs_per_add"] =
+        benchmark::Counter(static_cast<double>(allocated) / static_cast<double>(state.iterations() * (kNumLeaves - 1)));
+}
+
+BENCHMARK(hash_builder_10k_leaves)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <ethash/keccak.hpp>
+#include <silkworm/common/base.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
+#include <vector>
+
+using namespace silkworm;
+
+static constexpr size_t kNumInputs{1024};
+
+// Arg: length of every input (20 ~ address, 32 ~ storage location, 110 ~ transaction, 500 ~ 4 blocks)
+static std::vector<Bytes> make_inputs(size_t length) {
+    std::vector<Bytes> inputs(kNumInputs, Bytes(length, '\0'));
+    for (size_t i{0}; i < kNumInputs; ++i) {
+        for (size_t j{0}; j < length; ++j) {
+            inputs[i][j] = static_cast<uint8_t>(i * 131 + j);
+        }
+    }
+    return inputs;
+}
+
+static void keccak256_one_by_one(benchmark::State& state) {
+    const auto inputs{make_inputs(static_cast<size_t>(state.range(0)))};
+    std::vector<ethash::hash256> hashes(kNumInputs);
+    for (auto _ : state) {
+        for (size_t i{0}; i < kNumInputs; ++i) {
+            hashes[i] = ethash::keccak256(inputs[i].data(), inputs[i].length());
+        }
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumInputs);
+    state.SetBytesProcessed(state.iterations() * kNumInputs * state.range(0));
+}
+
+static void keccak256_batched(benchmark::State& state) {
+    const auto inputs{make_inputs(static_cast<size_t>(state.range(0)))};
+    const std::vector<ByteView> views(inputs.begin(), inputs.end());
+    std::vector<ethash::hash256> hashes(kNumInputs);
+    for (auto _ : state) {
+        crypto::keccak256_batch(hashes, views);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumInputs);
+    state.SetBytesProcessed(state.iterations() * kNumInputs * state.range(0));
+    state.counters["lanes"] = static_cast<double>(crypto::keccak256_batch_lanes());
+}
+
+BENCHMARK(keccak256_one_by_one)->Arg(20)->Arg(32)->Arg(110)->Arg(500)->Unit(benchmark::kMicrosecond);
+BENCHMARK(keccak256_batched)->Arg(20)->Arg(32)->Arg(110)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
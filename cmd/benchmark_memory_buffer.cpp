@@ -0,0 +1,78 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <silkworm/state/memory_buffer.hpp>
+
+using namespace silkworm;
+
+// Replays blocks the way Blockchain drives the buffer in consensus tests:
+// reads & updates of accounts and storage, then the state root of every block.
+// Arg: number of blocks
+
+static constexpr uint64_t kNumAccounts{500};
+static constexpr uint64_t kNumContracts{20};
+static constexpr uint64_t kAccountsPerBlock{40};
+static constexpr uint64_t kSlotsPerBlock{100};
+static constexpr uint64_t kIncarnation{1};
+
+static evmc::address make_address(uint64_t i) {
+    evmc::address address{};
+    std::memcpy(&address.bytes[kAddressLength - sizeof(i)], &i, sizeof(i));
+    return address;
+}
+
+static evmc::bytes32 make_location(uint64_t i) {
+    evmc::bytes32 location{};
+    std::memcpy(&location.bytes[kHashLength - sizeof(i)], &i, sizeof(i));
+    return location;
+}
+
+static void replay_blocks(benchmark::State& state) {
+    const auto num_blocks{static_cast<uint64_t>(state.range(0))};
+    for (auto _ : state) {
+        MemoryBuffer buffer;
+        uint64_t seed{0};
+        for (uint64_t block_number{1}; block_number <= num_blocks; ++block_number) {
+            buffer.begin_block(block_number);
+            for (uint64_t i{0}; i < kAccountsPerBlock; ++i) {
+                const evmc::address address{make_address(++seed * 7919 % kNumAccounts)};
+                const std::optional<Account> initial{buffer.read_account(address)};
+                Account current{initial.value_or(Account{})};
+                current.incarnation = kIncarnation;
+                ++current.nonce;
+                current.balance += kEther;
+                buffer.update_account(address, initial, current);
+            }
+            for (uint64_t i{0}; i < kSlotsPerBlock; ++i) {
+                const evmc::address address{make_address(++seed % kNumContracts)};
+                const evmc::bytes32 location{make_location(seed * 104729 % 1000)};
+                const evmc::bytes32 initial{buffer.read_storage(address, kIncarnation, location)};
+                evmc::bytes32 current{initial};
+                ++current.bytes[kHashLength - 1];
+                buffer.update_storage(address, kIncarnation, location, initial, current);
+            }
+            benchmark::DoNotOptimize(buffer.state_root_hash());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(replay_blocks)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -16,20 +16,174 @@
 
 #include <benchmark/benchmark.h>
 
+#include <random>
 #include <silkworm/common/util.hpp>
+#include <silkworm/crypto/ecdsa.hpp>
 #include <silkworm/execution/precompiled.hpp>
+#include <vector>
+
+using namespace silkworm;
+
+// Reports the gas charged per second of running alongside the time per run,
+// so that contracts priced too low relative to the others stand out
+static void run(benchmark::State& state, const precompiled::Contract& contract, ByteView input) {
+    const uint64_t gas{contract.gas(input, EVMC_ISTANBUL)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(contract.run(input));
+    }
+    state.counters["gas/s"] =
+        benchmark::Counter(static_cast<double>(gas), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static Bytes random_bytes(size_t n, std::mt19937_64& rng) {
+    Bytes out(n, '\0');
+    for (auto& b : out) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return out;
+}
 
 static void ec_recovery(benchmark::State& state) {
-    using namespace silkworm;
     Bytes in{
         *from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
                   "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
                   "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
-    for (auto _ : state) {
-        precompiled::ecrec_run(in);
+    run(state, precompiled::kContracts[0], in);
+}
+
+// Arg: input length
+
+static void sha256(benchmark::State& state) {
+    std::mt19937_64 rng{1};
+    run(state, precompiled::kContracts[1], random_bytes(static_cast<size_t>(state.range(0)), rng));
+}
+
+static void ripemd160(benchmark::State& state) {
+    std::mt19937_64 rng{1};
+    run(state, precompiled::kContracts[2], random_bytes(static_cast<size_t>(state.range(0)), rng));
+}
+
+static void identity(benchmark::State& state) {
+    std::mt19937_64 rng{1};
+    run(state, precompiled::kContracts[3], random_bytes(static_cast<size_t>(state.range(0)), rng));
+}
+
+// Args: length of the base & modulus, length of the exponent
+static void expmod(benchmark::State& state) {
+    const auto len{static_cast<uint64_t>(state.range(0))};
+    const auto exponent_len{static_cast<uint64_t>(state.range(1))};
+    std::mt19937_64 rng{1};
+
+    Bytes in(3 * 32, '\0');
+    intx::be::unsafe::store(&in[0], intx::uint256{len});
+    intx::be::unsafe::store(&in[32], intx::uint256{exponent_len});
+    intx::be::unsafe::store(&in[64], intx::uint256{len});
+    in += random_bytes(len, rng);           // base
+    in += random_bytes(exponent_len, rng);  // exponent
+    in[3 * 32 + len] |= 0x80;
+    Bytes modulus{random_bytes(len, rng)};
+    modulus.front() |= 0x80;
+    modulus.back() |= 1;
+    in += modulus;
+
+    run(state, precompiled::kContracts[4], in);
+}
+
+static void bn_add(benchmark::State& state) {
+    Bytes in{
+        *from_hex("00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+                  "00000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000"
+                  "000000010000000000000000000000000000000000000000000000000000000000000002")};
+    run(state, precompiled::kContracts[5], in);
+}
+
+static void bn_mul(benchmark::State& state) {
+    Bytes in{
+        *from_hex("1a87b0584ce92f4593d161480614f2989035225609f08058ccfa3d0f940febe31a2f3c951f6dadcc7ee"
+                  "9007dff81504b0fcd6d7cf59996efdc33d92bf7f9f8f600000000000000000000000000000000000000"
+                  "00000000000000000000000009")};
+    run(state, precompiled::kContracts[6], in);
+}
+
+// Arg: number of pairs
+static void snarkv(benchmark::State& state) {
+    // Generators of G1 & G2
+    const Bytes pair{
+        *from_hex("00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+                  "000000000000000000000000000000000002198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7"
+                  "aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e"
+                  "99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b"
+                  "4ce6cc0166fa7daa")};
+    Bytes in{};
+    for (int64_t i{0}; i < state.range(0); ++i) {
+        in += pair;
     }
+    run(state, precompiled::kContracts[7], in);
+}
+
+// Arg: number of rounds
+static void blake2_f(benchmark::State& state) {
+    // https://eips.ethereum.org/EIPS/eip-152#test-cases
+    Bytes in{
+        *from_hex("0000000c48c9bdf267e6096a3ba7ca8485ae67bb2bf894fe72f36e3cf1361d5f3af54fa5d182e6ad7f520e511f6c"
+                  "3e2b8c68059b6bbd41fbabd9831f79217e1319cde05b616263000000000000000000000000000000000000000000"
+                  "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+                  "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+                  "0000000000000000000000000300000000000000000000000000000001")};
+    const auto rounds{static_cast<uint32_t>(state.range(0))};
+    for (size_t i{0}; i < 4; ++i) {
+        in[i] = static_cast<uint8_t>(rounds >> (24 - 8 * i));
+    }
+    run(state, precompiled::kContracts[8], in);
 }
 
 BENCHMARK(ec_recovery);
+BENCHMARK(sha256)->Arg(32)->Arg(1024)->Arg(32 * 1024);
+BENCHMARK(ripemd160)->Arg(32)->Arg(1024)->Arg(32 * 1024);
+BENCHMARK(identity)->Arg(32)->Arg(1024)->Arg(32 * 1024);
+BENCHMARK(expmod)
+    ->Args({32, 3})
+    ->Args({32, 32})
+    ->Args({64, 64})
+    ->Args({128, 128})
+    ->Args({256, 3})
+    ->Args({256, 256})
+    ->Args({512, 512});
+BENCHMARK(bn_add);
+BENCHMARK(bn_mul);
+BENCHMARK(snarkv)->DenseRange(1, 10);
+BENCHMARK(blake2_f)->Arg(1)->Arg(12)->Arg(1'000)->Arg(100'000);
+
+static const Bytes kMessage{*from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c")};
+static const Bytes kSignature{
+    *from_hex("73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75feeb940b1d03b21e36b0e47e79769f095"
+              "fe2ab855bd91e3a38756b7d75a9c4549")};
+
+// Arg: number of signatures, e.g. the transactions of a block
+
+static void signature_recovery(benchmark::State& state) {
+    const auto n{static_cast<size_t>(state.range(0))};
+    for (auto _ : state) {
+        for (size_t i{0}; i < n; ++i) {
+            benchmark::DoNotOptimize(ecdsa::recover(kMessage, kSignature, 1));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same without allocating the public keys
+static void signature_recovery_in_place(benchmark::State& state) {
+    const auto n{static_cast<size_t>(state.range(0))};
+    ecdsa::PublicKey key;
+    for (auto _ : state) {
+        for (size_t i{0}; i < n; ++i) {
+            benchmark::DoNotOptimize(ecdsa::recover(key, kMessage, kSignature, 1));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(signature_recovery)->Arg(1)->Arg(200)->Unit(benchmark::kMicrosecond);
+BENCHMARK(signature_recovery_in_place)->Arg(1)->Arg(200)->Unit(benchmark::kMicrosecond);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,136 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/rlp/index.hpp>
+#include <silkworm/types/block.hpp>
+#include <silkworm/types/receipt.hpp>
+#include <silkworm/types/transaction.hpp>
+#include <vector>
+
+using namespace silkworm;
+
+// Arg: number of items in the block
+
+static std::vector<Transaction> make_transactions(size_t n) {
+    std::vector<Transaction> txns(n);
+    for (size_t i{0}; i < n; ++i) {
+        Transaction& txn{txns[i]};
+        txn.nonce = i;
+        txn.gas_price = 20 * kGiga;
+        txn.gas_limit = 100'000;
+        txn.to = 0x5df9b87991262f6ba471f09758cde1c0fc1de734_address;
+        txn.value = i * kEther;
+        txn.data = Bytes(4 + (i % 5) * 32, 0xab);
+        txn.v = 37;
+        txn.r = intx::uint256{i + 1} << 192;
+        txn.s = intx::uint256{i + 2} << 192;
+    }
+    return txns;
+}
+
+// Receipts with 0 to 3 logs of 3 topics each, like token transfers
+static std::vector<Receipt> make_receipts(size_t n) {
+    std::vector<Receipt> receipts(n);
+    for (size_t i{0}; i < n; ++i) {
+        Receipt& receipt{receipts[i]};
+        receipt.success = true;
+        receipt.cumulative_gas_used = 50'000 * (i + 1);
+        for (size_t j{0}; j < i % 4; ++j) {
+            std::vector<evmc::bytes32> topics(3);
+            for (size_t k{0}; k < topics.size(); ++k) {
+                topics[k].bytes[kHashLength - 1] = static_cast<uint8_t>(i + j + k);
+            }
+            receipt.logs.push_back(Log{0x8d12a197cb00d4747a1fe03395095ce2a5cc6819_address, topics,
+                                       Bytes(32, static_cast<uint8_t>(i))});
+        }
+        receipt.bloom = logs_bloom(receipt.logs);
+    }
+    return receipts;
+}
+
+// Receipts encoded back to back, as for the receipts root
+static void receipts_encoding(benchmark::State& state) {
+    const auto receipts{make_receipts(static_cast<size_t>(state.range(0)))};
+    Bytes rlp{};
+    for (auto _ : state) {
+        rlp.clear();
+        for (const auto& receipt : receipts) {
+            rlp::encode(rlp, receipt);
+        }
+        benchmark::DoNotOptimize(rlp.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Transactions encoded one by one, as for their signing hashes
+static void transactions_encoding_for_signing(benchmark::State& state) {
+    const auto txns{make_transactions(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        for (const auto& txn : txns) {
+            Bytes rlp{};
+            rlp::encode(rlp, txn, /*for_signing=*/true, /*eip155_chain_id=*/1);
+            benchmark::DoNotOptimize(rlp.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static Bytes make_block_body_rlp(size_t num_transactions) {
+    BlockBody body;
+    body.transactions = make_transactions(num_transactions);
+    body.ommers.resize(2);
+    for (size_t i{0}; i < body.ommers.size(); ++i) {
+        body.ommers[i].number = 12'000'000 + i;
+        body.ommers[i].difficulty = 3'000'000 * kGiga;
+        body.ommers[i].gas_limit = 12'500'000;
+    }
+    Bytes rlp{};
+    rlp::encode(rlp, body);
+    return rlp;
+}
+
+// Validation of stored block bodies by recursive decoding
+static void block_body_decoding(benchmark::State& state) {
+    const Bytes rlp{make_block_body_rlp(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        ByteView view{rlp};
+        BlockBody body;
+        benchmark::DoNotOptimize(rlp::decode(view, body));
+    }
+    state.SetBytesProcessed(state.iterations() * rlp.length());
+}
+
+// Validation of stored block bodies by building their structural index
+static void block_body_indexing(benchmark::State& state) {
+    const Bytes rlp{make_block_body_rlp(static_cast<size_t>(state.range(0)))};
+    rlp::StructuralIndex index;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.build(rlp));
+    }
+    state.SetBytesProcessed(state.iterations() * rlp.length());
+}
+
+BENCHMARK(receipts_encoding)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(transactions_encoding_for_signing)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(block_body_decoding)->Arg(200)->Unit(benchmark::kMicrosecond);
+BENCHMARK(block_body_indexing)->Arg(200)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
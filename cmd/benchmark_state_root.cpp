@@ -0,0 +1,144 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/state/memory_buffer.hpp>
+#include <silkworm/trie/parallel_root.hpp>
+#include <thread>
+
+using namespace silkworm;
+
+static evmc::address make_address(uint64_t i) {
+    evmc::address address{};
+    std::memcpy(&address.bytes[kAddressLength - sizeof(i)], &i, sizeof(i));
+    return address;
+}
+
+static Account make_account(uint64_t i) {
+    Account account;
+    account.nonce = i % 1000;
+    account.balance = intx::uint256{i} * kEther;
+    return account;
+}
+
+// Synthetic account trie leaves, built once per size
+static const trie::Leaves& account_leaves(size_t n) {
+    static std::map<size_t, trie::Leaves> cache;
+    auto& leaves{cache[n]};
+    if (leaves.empty()) {
+        leaves.resize(n);
+        for (uint64_t i{0}; i < n; ++i) {
+            leaves[i].first = to_bytes32(full_view(keccak256(full_view(make_address(i))).bytes));
+            rlp::encode(leaves[i].second, make_account(i));
+        }
+        std::sort(leaves.begin(), leaves.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+    return leaves;
+}
+
+// Synthetic state : externally owned accounts plus a contract with large storage every 100k accounts
+static std::unique_ptr<MemoryBuffer> make_memory_state(size_t n) {
+    auto buffer{std::make_unique<MemoryBuffer>()};
+    buffer->begin_block(0);
+    for (uint64_t i{0}; i < n; ++i) {
+        Account account{make_account(i)};
+        const bool contract{i % 100'000 == 0};
+        if (contract) {
+            account.incarnation = 1;
+        }
+        buffer->update_account(make_address(i), std::nullopt, account);
+        if (contract) {
+            for (uint64_t j{1}; j <= 10'000; ++j) {
+                buffer->update_storage(make_address(i), 1, to_bytes32(full_view(make_address(j))), {},
+                                       to_bytes32(full_view(make_address(i + j))));
+            }
+        }
+    }
+    return buffer;
+}
+
+static void thread_args(benchmark::internal::Benchmark* b) {
+    const int64_t max_threads{std::max<int64_t>(1, std::thread::hardware_concurrency())};
+    for (int64_t n : {1 << 20, 1 << 22}) {
+        for (int64_t threads{1}; threads <= max_threads; threads *= 2) {
+            b->Args({n, threads});
+        }
+    }
+}
+
+// Account trie only : serial (1 thread) vs parallel root builder
+static void parallel_root_hash(benchmark::State& state) {
+    const auto& leaves{account_leaves(static_cast<size_t>(state.range(0)))};
+    const auto num_threads{static_cast<unsigned>(state.range(1))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie::parallel_root_hash(leaves, num_threads));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(parallel_root_hash)->Apply(thread_args)->Unit(benchmark::kMillisecond);
+
+// Whole state root from scratch including address hashing, RLP encoding and storage tries
+static void memory_buffer_state_root(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto buffer{make_memory_state(static_cast<size_t>(state.range(0)))};
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(buffer->state_root_hash());
+
+        state.PauseTiming();
+        buffer.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(memory_buffer_state_root)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+// State root after a block changing 1000 accounts, out of the tries cached for the previous block
+static void memory_buffer_state_root_update(benchmark::State& state) {
+    static std::map<size_t, std::unique_ptr<MemoryBuffer>> cache;
+    const auto n{static_cast<uint64_t>(state.range(0))};
+    auto& buffer{cache[n]};
+    if (!buffer) {
+        buffer = make_memory_state(n);
+        buffer->state_root_hash();
+    }
+
+    uint64_t block_number{0};
+    for (auto _ : state) {
+        buffer->begin_block(++block_number);
+        for (uint64_t i{0}; i < 1000; ++i) {
+            const evmc::address address{make_address((block_number * 1000 + i) * 7919 % n)};
+            const std::optional<Account> initial{buffer->read_account(address)};
+            Account current{*initial};
+            ++current.nonce;
+            buffer->update_account(address, initial, current);
+        }
+        benchmark::DoNotOptimize(buffer->state_root_hash());
+    }
+}
+
+BENCHMARK(memory_buffer_state_root_update)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
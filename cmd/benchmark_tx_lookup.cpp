@@ -0,0 +1,113 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <boost/endian/conversion.hpp>
+#include <silkworm/common/temp_dir.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/tx_lookup.hpp>
+#include <silkworm/db/util.hpp>
+
+using namespace silkworm;
+
+// Times both paths of TxLookup stage over the same range of new blocks in order to find
+// the crossover below which tx_lookup merges in memory (see default_incremental_max_blocks in tx_lookup.cpp).
+// Args: number of blocks [, number of extraction threads]
+
+static constexpr uint64_t kNumBlocks{16'384};
+static constexpr uint64_t kTxsPerBlock{150};  // About mainnet average
+static constexpr size_t kTxSize{200};
+
+// A database holding kNumBlocks bodies and their transactions, built once
+struct Fixture {
+    Fixture() {
+        lmdb::DatabaseConfig db_config{db_dir.path(), 8 * kGibi};
+        db_config.set_readonly(false);
+        env = lmdb::get_env(db_config);
+        auto txn{env->begin_rw_transaction()};
+        db::table::create_all(*txn);
+        auto bodies_table{txn->open(db::table::kBlockBodies)};
+        auto transactions_table{txn->open(db::table::kEthTx)};
+
+        uint64_t txn_id{0};
+        const uint8_t hash[kHashLength]{};
+        Bytes key(8, '\0');
+        Bytes payload(kTxSize, '\0');
+        for (uint64_t block_number{1}; block_number <= kNumBlocks; ++block_number) {
+            db::detail::BlockBodyForStorage body{txn_id, kTxsPerBlock, {}};
+            bodies_table->put(db::block_key(block_number, hash), body.encode());
+            for (uint64_t i{0}; i < kTxsPerBlock; ++i, ++txn_id) {
+                boost::endian::store_big_u64(&key[0], txn_id);
+                std::copy(key.begin(), key.end(), payload.begin());  // Distinct transactions
+                transactions_table->put(key, payload);
+            }
+        }
+        lmdb::err_handler(txn->commit());
+    }
+
+    TemporaryDirectory db_dir;
+    std::shared_ptr<lmdb::Environment> env;
+};
+
+static Fixture& fixture() {
+    static Fixture instance;
+    return instance;
+}
+
+// Leaves the fixture as it was for next iteration
+static void discard_tx_lookup(lmdb::Transaction& txn) {
+    lmdb::err_handler(txn.open(db::table::kTxLookup, MDB_CREATE)->clear());
+    txn.abort();
+}
+
+static void incremental_merge(benchmark::State& state) {
+    auto& env{*fixture().env};
+    const auto num_blocks{static_cast<uint64_t>(state.range(0))};
+    for (auto _ : state) {
+        auto txn{env.begin_rw_transaction()};
+        benchmark::DoNotOptimize(db::tx_lookup::merge_tx_hashes(*txn, 1, num_blocks));
+        state.PauseTiming();
+        discard_tx_lookup(*txn);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void etl_extract_and_load(benchmark::State& state) {
+    auto& env{*fixture().env};
+    const auto num_blocks{static_cast<uint64_t>(state.range(0))};
+    const auto num_threads{static_cast<uint32_t>(state.range(1))};
+    for (auto _ : state) {
+        TemporaryDirectory etl_dir;  // Removed by the collector once loaded
+        auto txn{env.begin_rw_transaction()};
+        auto bodies_table{txn->open(db::table::kBlockBodies)};
+        auto partitions{db::tx_lookup::split_by_txn_count(*bodies_table, 1, num_blocks, num_threads)};
+        etl::ShardedCollector collector(num_threads, etl_dir.path(), /* flush size */ 512 * kMebi);
+        db::tx_lookup::collect_tx_hashes(env, partitions, collector);
+        auto target_table{txn->open(db::table::kTxLookup, MDB_CREATE)};
+        collector.load(target_table.get(), nullptr, /* db_flags = */ 0u);  // No MDB_APPEND as on a synced node
+        state.PauseTiming();
+        discard_tx_lookup(*txn);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(incremental_merge)->RangeMultiplier(4)->Range(16, kNumBlocks)->Unit(benchmark::kMillisecond);
+BENCHMARK(etl_extract_and_load)->RangeMultiplier(4)->Ranges({{16, kNumBlocks}, {1, 8}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
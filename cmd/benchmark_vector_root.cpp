@@ -0,0 +1,100 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/vector_root.hpp>
+#include <silkworm/types/receipt.hpp>
+#include <silkworm/types/transaction.hpp>
+#include <vector>
+
+using namespace silkworm;
+
+// Arg: number of items in the block
+
+static std::vector<Transaction> make_transactions(size_t n) {
+    std::vector<Transaction> txns(n);
+    for (size_t i{0}; i < n; ++i) {
+        Transaction& txn{txns[i]};
+        txn.nonce = i;
+        txn.gas_price = 20 * kGiga;
+        txn.gas_limit = 21'000;
+        txn.to = 0x5df9b87991262f6ba471f09758cde1c0fc1de734_address;
+        txn.value = i * kEther;
+        txn.data = Bytes(i % 100, 0xab);
+        txn.v = 27;
+        txn.r = intx::uint256{i + 1} << 192;
+        txn.s = intx::uint256{i + 2} << 192;
+    }
+    return txns;
+}
+
+static std::vector<Receipt> make_receipts(size_t n) {
+    std::vector<Receipt> receipts(n);
+    for (size_t i{0}; i < n; ++i) {
+        Receipt& receipt{receipts[i]};
+        receipt.success = true;
+        receipt.cumulative_gas_used = 21'000 * (i + 1);
+        if (i % 2) {
+            evmc::bytes32 topic{};
+            topic.bytes[kHashLength - 1] = static_cast<uint8_t>(i);
+            receipt.logs.push_back(Log{0x8d12a197cb00d4747a1fe03395095ce2a5cc6819_address, {topic},
+                                       Bytes(64, static_cast<uint8_t>(i))});
+        }
+        receipt.bloom = logs_bloom(receipt.logs);
+    }
+    return receipts;
+}
+
+static void transactions_root_generic(benchmark::State& state) {
+    const auto txns{make_transactions(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie::generic_root_hash(txns));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void transactions_root_ordered_list(benchmark::State& state) {
+    const auto txns{make_transactions(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie::root_hash(txns));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void receipts_root_generic(benchmark::State& state) {
+    const auto receipts{make_receipts(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie::generic_root_hash(receipts));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void receipts_root_ordered_list(benchmark::State& state) {
+    const auto receipts{make_receipts(static_cast<size_t>(state.range(0)))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie::root_hash(receipts));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(transactions_root_generic)->Arg(10)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(transactions_root_ordered_list)->Arg(10)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(receipts_root_generic)->Arg(10)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(receipts_root_ordered_list)->Arg(10)->Arg(200)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
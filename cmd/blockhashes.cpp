@@ -15,25 +15,99 @@
 */
 
 #include <CLI/CLI.hpp>
+#include <algorithm>
+#include <atomic>
 #include <boost/endian/conversion.hpp>
 #include <boost/filesystem.hpp>
+#include <exception>
 #include <iostream>
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/tables.hpp>
-#include <silkworm/etl/collector.hpp>
+#include <silkworm/etl/sharded_collector.hpp>
+#include <thread>
 
 using namespace silkworm;
 
+static unsigned get_host_cpus() {
+    unsigned n{std::thread::hardware_concurrency()};
+    return n ? n : 2;
+}
+
+// Number of blocks claimed at once by an extraction thread
+constexpr uint64_t kChunkSize{10'000};
+
+// Extracts header hashes of blocks in range [from, to] using a dedicated ro transaction
+// and collects them into the given shard. Returns the number of blocks processed
+static uint64_t extract_block_hashes(lmdb::Environment& env, uint64_t from, uint64_t to,
+                                     etl::ShardedCollector& collector, size_t shard) {
+    std::unique_ptr<lmdb::Transaction> txn{env.begin_ro_transaction()};
+    auto header_table{txn->open(db::table::kBlockHeaders)};
+    auto expected_block_number{from};
+
+    Bytes start(8, '\0');
+    boost::endian::store_big_u64(&start[0], expected_block_number);
+    MDB_val mdb_key{db::to_mdb_val(start)};
+    MDB_val mdb_data;
+    int rc{header_table->seek(&mdb_key, &mdb_data)};  // Sets cursor to nearest key greater equal than this
+    while (!rc) { /* Loop as long as we have no errors*/
+
+        if (mdb_key.mv_size != 40) {
+            // Not the key we need
+            rc = header_table->get_next(&mdb_key, &mdb_data);
+            continue;
+        }
+
+        // Ensure the reached block number is in proper sequence
+        Bytes mdb_key_as_bytes{static_cast<uint8_t*>(mdb_key.mv_data), mdb_key.mv_size};
+        auto reached_block_number{boost::endian::load_big_u64(&mdb_key_as_bytes[0])};
+        if (reached_block_number > to) {
+            break;
+        }
+        if (reached_block_number != expected_block_number) {
+            // Something wrong with db
+            // Blocks are out of sequence for any reason
+            // Should not happen but you never know
+            throw std::runtime_error("Bad headers sequence. Expected " + std::to_string(expected_block_number) +
+                " got " + std::to_string(reached_block_number));
+
+        }
+
+        // We reached a valid block height in proper sequence
+        // Load data into collector
+        etl::Entry etl_entry{mdb_key_as_bytes.substr(8, 40), mdb_key_as_bytes.substr(0, 8)};
+        collector.collect(shard, etl_entry);
+
+        // Expect next in sequence
+        ++expected_block_number;
+        rc = header_table->get_next(&mdb_key, &mdb_data);
+    }
+
+    if (rc && rc != MDB_NOTFOUND) { /* MDB_NOTFOUND is not actually an error rather eof */
+        lmdb::err_handler(rc);
+    }
+
+    // Chunks are contiguous hence each must be fully covered
+    if (expected_block_number != to + 1) {
+        throw std::runtime_error("Bad headers sequence. Expected " + std::to_string(expected_block_number) +
+            " got none");
+    }
+
+    return expected_block_number - from;
+}
+
 int main(int argc, char* argv[]) {
     namespace fs = boost::filesystem;
 
     CLI::App app{"Generates Blockhashes => BlockNumber mapping in database"};
 
     std::string db_path{db::default_path()};
+    uint32_t numthreads{get_host_cpus()};
     app.add_option("-d,--datadir", db_path, "Path to a database populated by Turbo-Geth", true)
         ->check(CLI::ExistingDirectory);
+    app.add_option("--threads", numthreads, "Number of extraction threads", true)
+        ->check(CLI::Range(1u, get_host_cpus()));
     CLI11_PARSE(app, argc, argv);
 
 
@@ -46,7 +120,7 @@ int main(int argc, char* argv[]) {
     fs::path datadir(db_path);
     fs::path etl_path(datadir.parent_path() / fs::path("etl-temp"));
     fs::create_directories(etl_path);
-    etl::Collector collector(etl_path.string().c_str(), /* flush size */ 512 * kMebi);
+    etl::ShardedCollector collector(numthreads, etl_path.string().c_str(), /* flush size */ 512 * kMebi);
 
     lmdb::DatabaseConfig db_config{db_path};
     db_config.set_readonly(false);
@@ -54,60 +128,65 @@ int main(int argc, char* argv[]) {
     std::unique_ptr<lmdb::Transaction> txn{env->begin_rw_transaction()};
     // We take data from header table and transform it and put it in blockhashes table
     auto header_table{txn->open(db::table::kBlockHeaders)};
-    auto blockhashes_table{txn->open(db::table::kHeaderNumbers)};
 
     try {
 
         auto last_processed_block_number{db::stages::get_stage_progress(*txn, db::stages::kBlockHashesKey)};
-        auto expected_block_number{last_processed_block_number + 1};
-        uint32_t block_number{0};
-        uint32_t blocks_processed_count{0};
+        uint64_t block_number{0};
+        uint64_t blocks_processed_count{0};
+
+        // Locate the highest header available (header keys are 40 bytes long)
+        MDB_val mdb_key, mdb_data;
+        int rc{header_table->get_last(&mdb_key, &mdb_data)};
+        while (!rc && mdb_key.mv_size != 40) {
+            rc = header_table->get_prev(&mdb_key, &mdb_data);
+        }
+        if (rc && rc != MDB_NOTFOUND) {
+            lmdb::err_handler(rc);
+        }
+        uint64_t from{last_processed_block_number + 1};
+        uint64_t to{rc ? 0 : boost::endian::load_big_u64(static_cast<uint8_t*>(mdb_key.mv_data))};
 
         // Extract
-        Bytes start(8, '\0');
-        boost::endian::store_big_u64(&start[0], expected_block_number);
-        MDB_val mdb_key{db::to_mdb_val(start)};
-        MDB_val mdb_data;
-        SILKWORM_LOG(LogInfo) << "Started BlockHashes Extraction" << std::endl;
-        int rc{header_table->seek(&mdb_key, &mdb_data)};  // Sets cursor to nearest key greater equal than this
-        while (!rc) { /* Loop as long as we have no errors*/
-
-            if (mdb_key.mv_size != 40) {
-                // Not the key we need
-                rc = header_table->get_next(&mdb_key, &mdb_data);
-                continue;
+        // Threads repeatedly claim the next small chunk of the block range and collect it
+        // into their own shard (each chunk read by a short lived ro transaction). Handing out
+        // chunks dynamically keeps all threads busy till the end whatever the cost of each range
+        if (to >= from) {
+            std::atomic<uint64_t> next_chunk_from{from};
+            std::vector<std::thread> workers;
+            std::vector<uint64_t> processed(numthreads, 0);
+            std::vector<std::exception_ptr> errors(numthreads);
+
+            SILKWORM_LOG(LogInfo) << "Started BlockHashes Extraction (" << numthreads << " threads)" << std::endl;
+            for (uint32_t i{0}; i < numthreads; ++i) {
+                workers.emplace_back([&, i]() {
+                    try {
+                        for (uint64_t chunk_from{next_chunk_from.fetch_add(kChunkSize)}; chunk_from <= to;
+                             chunk_from = next_chunk_from.fetch_add(kChunkSize)) {
+                            uint64_t chunk_to{std::min(to, chunk_from + kChunkSize - 1)};
+                            processed[i] += extract_block_hashes(*env, chunk_from, chunk_to, collector, i);
+                        }
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                        next_chunk_from = to + 1;  // Make other threads stop
+                    }
+                });
             }
-
-            // Ensure the reached block number is in proper sequence
-            Bytes mdb_key_as_bytes{static_cast<uint8_t*>(mdb_key.mv_data), mdb_key.mv_size};
-            auto reached_block_number{boost::endian::load_big_u64(&mdb_key_as_bytes[0])};
-            if (reached_block_number != expected_block_number) {
-                // Something wrong with db
-                // Blocks are out of sequence for any reason
-                // Should not happen but you never know
-                throw std::runtime_error("Bad headers sequence. Expected " + std::to_string(expected_block_number) +
-                    " got " + std::to_string(reached_block_number));
-
+            for (auto& worker : workers) {
+                worker.join();
             }
-
-            // We reached a valid block height in proper sequence
-            // Load data into collector
-            etl::Entry etl_entry{mdb_key_as_bytes.substr(8, 40), mdb_key_as_bytes.substr(0, 8)};
-            collector.collect(etl_entry);
-
-            // Save last processed block_number and expect next in sequence
-            ++blocks_processed_count;
-            block_number = expected_block_number++;
-            rc = header_table->get_next(&mdb_key, &mdb_data);
-        }
-
-        if (rc && rc != MDB_NOTFOUND) { /* MDB_NOTFOUND is not actually an error rather eof */
-            lmdb::err_handler(rc);
+            for (auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+            for (auto count : processed) {
+                blocks_processed_count += count;
+            }
+            block_number = to;
         }
 
-
         SILKWORM_LOG(LogInfo) << "Entries Collected << " << blocks_processed_count << std::endl;
-
         // Proceed only if we've done something
         if (blocks_processed_count) {
             SILKWORM_LOG(LogInfo) << "Started BlockHashes Loading" << std::endl;
@@ -66,6 +66,7 @@ int main(int argc, char* argv[]) {
 
     AnalysisCache analysis_cache;
     ExecutionStatePool state_pool;
+    PrecompileCache precompile_cache;
 
     uint64_t block_num{from};
     for (; block_num < to; ++block_num) {
@@ -78,7 +79,8 @@ int main(int argc, char* argv[]) {
 
         db::Buffer buffer{txn.get(), block_num};
 
-        ValidationResult err{execute_block(bh->block, buffer, kMainnetConfig, &analysis_cache, &state_pool).second};
+        ValidationResult err{
+            execute_block(bh->block, buffer, kMainnetConfig, &analysis_cache, &state_pool, &precompile_cache).second};
         if (err != ValidationResult::kOk) {
             std::cerr << "Failed to execute block " << block_num << "\n";
             continue;
@@ -134,5 +136,6 @@ int main(int argc, char* argv[]) {
 
     t1 = absl::Now();
     std::cout << t1 << " Blocks [" << from << "; " << block_num << ") have been checked\n";
+    precompile_cache.report(std::cout);
     return 0;
 }
@@ -0,0 +1,143 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstring>
+#include <silkworm/chain/ethash_epochs.hpp>
+#include <silkworm/chain/validity.hpp>
+#include <silkworm/common/log.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <thread>
+#include <vector>
+
+using namespace silkworm;
+
+// Canonical header of a block, if any
+static std::optional<BlockHeader> read_canonical_header(lmdb::Table& header_table, uint64_t block_number) {
+    std::optional<ByteView> hash{header_table.get(db::header_hash_key(block_number))};
+    if (!hash || hash->length() != kHashLength) {
+        return std::nullopt;
+    }
+    uint8_t hash_bytes[kHashLength];
+    std::memcpy(hash_bytes, hash->data(), kHashLength);
+
+    std::optional<ByteView> rlp{header_table.get(db::block_key(block_number, hash_bytes))};
+    if (!rlp) {
+        return std::nullopt;
+    }
+    BlockHeader header;
+    if (rlp::decode(*rlp, header) != rlp::DecodingResult::kOk) {
+        throw std::runtime_error("Can't decode header of block " + std::to_string(block_number));
+    }
+    return header;
+}
+
+int main(int argc, char* argv[]) {
+    CLI::App app{"Validates canonical block headers again, batches of them concurrently"};
+
+    std::string db_path{db::default_path()};
+    uint64_t block_from{1};
+    uint64_t block_to{UINT64_MAX};
+    unsigned num_threads{std::max(1u, std::thread::hardware_concurrency())};
+    size_t batch_size{10'000};
+    bool verify_pow{false};
+    app.add_option("-d,--datadir", db_path, "Path to a database populated by Turbo-Geth", true)
+        ->check(CLI::ExistingDirectory);
+    app.add_option("--from", block_from, "Initial block number to validate (inclusive)", true)
+        ->check(CLI::Range(uint64_t{1}, UINT64_MAX));
+    app.add_option("--to", block_to, "Final block number to validate (exclusive)", true);
+    app.add_option("--threads", num_threads, "Number of validation threads", true)->check(CLI::Range(1u, 1024u));
+    app.add_option("--batch", batch_size, "Number of headers to validate per batch", true)
+        ->check(CLI::Range(size_t{1}, size_t{10'000'000}));
+    app.add_flag("--pow", verify_pow, "Verify the Ethash proof of work too");
+    CLI11_PARSE(app, argc, argv);
+
+    // Check data.mdb exists in provided directory
+    boost::filesystem::path db_file{boost::filesystem::path(db_path) / boost::filesystem::path("data.mdb")};
+    if (!boost::filesystem::exists(db_file)) {
+        SILKWORM_LOG(LogError) << "Can't find a valid TG data file in " << db_path << std::endl;
+        return -1;
+    }
+
+    EthashEpochManager ethash_epochs;
+
+    try {
+        lmdb::DatabaseConfig db_config{db_path};
+        std::shared_ptr<lmdb::Environment> env{lmdb::get_env(db_config)};
+
+        // Each batch is headed by the parent of its first header
+        std::vector<BlockHeader> headers;
+        {
+            std::unique_ptr<lmdb::Transaction> txn{env->begin_ro_transaction()};
+            auto header_table{txn->open(db::table::kBlockHeaders)};
+            std::optional<BlockHeader> parent{read_canonical_header(*header_table, block_from - 1)};
+            if (!parent) {
+                SILKWORM_LOG(LogError) << "Missing header of block " << block_from - 1 << std::endl;
+                return -1;
+            }
+            headers.push_back(*parent);
+        }
+
+        const auto start{std::chrono::steady_clock::now()};
+        uint64_t block_num{block_from};
+        while (block_num < block_to) {
+            // Short read-only transactions, as Turbo-Geth may be syncing the same database
+            {
+                std::unique_ptr<lmdb::Transaction> txn{env->begin_ro_transaction()};
+                auto header_table{txn->open(db::table::kBlockHeaders)};
+                for (; block_num < block_to && headers.size() <= batch_size; ++block_num) {
+                    std::optional<BlockHeader> header{read_canonical_header(*header_table, block_num)};
+                    if (!header) {
+                        block_to = block_num;
+                        break;
+                    }
+                    headers.push_back(*header);
+                }
+            }
+            if (headers.size() < 2) {
+                break;
+            }
+
+            auto [index, err]{validate_header_range(headers, num_threads, kMainnetConfig,
+                                                    verify_pow ? &ethash_epochs : nullptr)};
+            if (err != ValidationResult::kOk) {
+                SILKWORM_LOG(LogError) << "Validation error " << static_cast<int>(err) << " at block "
+                                       << headers[index].number << std::endl;
+                return 1;
+            }
+
+            const auto elapsed{std::chrono::duration<double>(std::chrono::steady_clock::now() - start)};
+            SILKWORM_LOG(LogInfo) << "Validated headers up to block " << headers.back().number << " ("
+                                  << static_cast<uint64_t>((headers.back().number - block_from + 1) / elapsed.count())
+                                  << " headers/s)" << std::endl;
+
+            headers.erase(headers.begin(), headers.end() - 1);
+        }
+
+        SILKWORM_LOG(LogInfo) << "All headers before block " << block_num << " are valid" << std::endl;
+    } catch (const std::exception& ex) {
+        SILKWORM_LOG(LogError) << ex.what() << std::endl;
+        return -5;
+    }
+    return 0;
+}
@@ -137,6 +137,7 @@ class Recoverer : public silkworm::Worker {
                 size_t block_result_length{0};
 
                 // Loop
+                ecdsa::PublicKey recovered;
                 for (auto const& package : packages_) {
                     // On block switching store the results
                     if (current_block != package.block_num) {
@@ -148,10 +149,9 @@ class Recoverer : public silkworm::Worker {
                         if (should_stop_) break;
                     }
 
-                    std::optional<Bytes> recovered{ecdsa::recover(full_view(package.hash.bytes),
-                                                                  full_view(package.signature), package.recovery_id)};
-                    if (recovered.has_value() && (int)recovered->at(0) == 4) {
-                        auto keyHash{ethash::keccak256(recovered->data() + 1, recovered->length() - 1)};
+                    if (ecdsa::recover(recovered, full_view(package.hash.bytes), full_view(package.signature),
+                                       package.recovery_id)) {
+                        auto keyHash{ethash::keccak256(&recovered[1], recovered.size() - 1)};
                         std::memcpy(&mydata_[block_result_offset + block_result_length],
                                     &keyHash.bytes[sizeof(keyHash) - kAddressLength], kAddressLength);
                         block_result_length += kAddressLength;
@@ -179,16 +179,35 @@ class Recoverer : public silkworm::Worker {
     };
 };
 
-void process_txs_for_signing(ChainConfig& config, uint64_t block_num, std::vector<silkworm::Transaction>& transactions,
-                             std::vector<Recoverer::package>& packages) {
-    for (const auto& txn : transactions) {
-        if (!silkworm::ecdsa::is_valid_signature(txn.r, txn.s, config.has_homestead(block_num))) {
+// Returns the number of transactions enqueued
+size_t process_txs_for_signing(ChainConfig& config, uint64_t block_num, lmdb::Table& transactions_table,
+                               uint64_t base_txn_id, uint64_t txn_count, std::vector<Recoverer::package>& packages) {
+    Bytes txn_key(8, '\0');
+    boost::endian::store_big_u64(txn_key.data(), base_txn_id);
+    MDB_val key_mdb{db::to_mdb_val(txn_key)};
+    MDB_val data_mdb{};
+
+    // Transactions are only viewed in the database: the signing payload is copied out of their encoding
+    Bytes rlp{};
+    uint64_t i{0};
+    for (int rc{transactions_table.seek_exact(&key_mdb, &data_mdb)}; rc != MDB_NOTFOUND && i < txn_count;
+         rc = transactions_table.get_next(&key_mdb, &data_mdb), ++i) {
+        lmdb::err_handler(rc);
+        ByteView data{db::from_mdb_val(data_mdb)};
+        TransactionView txn;
+        if (rlp::decode(data, txn) != rlp::DecodingResult::kOk) {
+            throw std::runtime_error("Got invalid tx RLP for block number " + std::to_string(block_num));
+        }
+
+        const intx::uint256 r{txn.r()};
+        const intx::uint256 s{txn.s()};
+        if (!silkworm::ecdsa::is_valid_signature(r, s, config.has_homestead(block_num))) {
             throw std::runtime_error("Got invalid signature in tx for block number " + std::to_string(block_num));
         }
 
-        ecdsa::RecoveryId x{ecdsa::get_signature_recovery_id(txn.v)};
+        ecdsa::RecoveryId x{ecdsa::get_signature_recovery_id(txn.v())};
 
-        Bytes rlp{};
+        rlp.clear();
         if (x.eip155_chain_id) {
             if (!config.has_spurious_dragon(block_num)) {
                 throw std::runtime_error("EIP-155 signature in tx before Spurious Dragon for block number " +
@@ -199,17 +218,18 @@ void process_txs_for_signing(ChainConfig& config, uint64_t block_num, std::vecto
                                          std::to_string(config.chain_id) + " got " +
                                          intx::to_string(*x.eip155_chain_id));
             }
-            rlp::encode(rlp, txn, true, {config.chain_id});
+            txn.encode_for_signing(rlp, {config.chain_id});
         } else {
-            rlp::encode(rlp, txn, true, {});
+            txn.encode_for_signing(rlp, {});
         }
 
         auto hash{keccak256(rlp)};
         Recoverer::package rp{block_num, hash, x.recovery_id};
-        intx::be::unsafe::store(rp.signature, txn.r);
-        intx::be::unsafe::store(rp.signature + 32, txn.s);
+        intx::be::unsafe::store(rp.signature, r);
+        intx::be::unsafe::store(rp.signature + 32, s);
         packages.push_back(rp);
     }
+    return i;
 }
 
 bool start_workers(std::vector<std::unique_ptr<Recoverer>>& workers) {
@@ -518,7 +538,7 @@ int do_recover(app_options_t& options) {
                 }
 
                 auto body_rlp{db::from_mdb_val(mdb_data)};
-                auto body{db::detail::decode_stored_block_body(body_rlp)};
+                auto body{db::detail::decode_stored_block_body_view(body_rlp)};
 
                 // We get here with a matching block number + header
                 // Process it if not empty (ie 0 transactions and 0 ommers)
@@ -562,13 +582,9 @@ int do_recover(app_options_t& options) {
                         }
                     }
 
-                    // Load transactions
-                    std::vector<Transaction> transactions{
-                        db::read_transactions(*transactions_table, body.base_txn_id, body.txn_count)};
-
                     // Enqueue Txs in current batch
-                    process_txs_for_signing(config, current_block, transactions, recoverPackages);
-                    batch_size += transactions.size();
+                    batch_size += process_txs_for_signing(config, current_block, *transactions_table,
+                                                          body.base_txn_id, body.txn_count, recoverPackages);
                 }
 
                 // After processing move to next block number and header
@@ -722,11 +738,8 @@ int do_verify(app_options_t& options) {
                       << " " << std::left << std::setw(42) << std::setfill('-') << "" << std::endl;
 
             for (size_t i = 0; i < bh->block.transactions.size(); i++) {
-                Bytes rlp{};
-                rlp::encode(rlp, bh->block.transactions.at(i), /*forsigning*/ false, {});
-                ethash::hash256 hash{ethash::keccak256(rlp.data(), rlp.length())};
-                ByteView bv{hash.bytes, 32};
-                std::cout << std::right << std::setw(4) << std::setfill(' ') << i << " 0x" << to_hex(bv) << " 0x"
+                std::cout << std::right << std::setw(4) << std::setfill(' ') << i << " 0x"
+                          << to_hex(bh->block.transactions.at(i).hash()) << " 0x"
                           << to_hex(*(bh->block.transactions.at(i).from)) << " 0x"
                           << to_hex(*(bh->block.transactions.at(i).to)) << std::endl;
             }
@@ -92,7 +92,7 @@ int main(int argc, char* argv[]) {
             Bytes block_key(static_cast<const uint8_t*>(mdb_key.mv_data), mdb_key.mv_size);
             auto block_number(boost::endian::load_big_u64(&block_key[0]));
             auto body_rlp{db::from_mdb_val(mdb_data)};
-            auto body{db::detail::decode_stored_block_body(body_rlp)};
+            auto body{db::detail::decode_stored_block_body_view(body_rlp)};
 
             if (body.txn_count > 0) {
                 Bytes transaction_key(8, '\0');
@@ -29,6 +29,7 @@
 #include <silkworm/state/intra_block_state.hpp>
 #include <silkworm/state/memory_buffer.hpp>
 #include <silkworm/types/block.hpp>
+#include <silkworm/types/sender_cache.hpp>
 #include <string>
 #include <string_view>
 
@@ -234,6 +235,9 @@ void init_pre_state(const nlohmann::json& pre, StateBuffer& state) {
     }
 }
 
+// Shared by the blockchain tests: forks & reorgs execute the same transactions again
+static SenderCache sender_cache;
+
 enum Status { kPassed, kFailed, kSkipped };
 
 Status run_block(const nlohmann::json& json_block, Blockchain& blockchain) {
@@ -345,7 +349,7 @@ bool post_check(const MemoryBuffer& state, const nlohmann::json& expected) {
 Status blockchain_test(const nlohmann::json& json_test, std::optional<ChainConfig>) {
     std::string seal_engine{json_test["sealEngine"].get<std::string>()};
     if (seal_engine != "NoProof") {
-        // TODO[Issue 144] Support Ethash sealEngine
+        // TODO[Issue 144] Support Ethash sealEngine (verify_ethash) once the suite passes with it
         std::cout << seal_engine << " seal engine is not supported yet\n";
         return kSkipped;
     }
@@ -361,6 +365,7 @@ Status blockchain_test(const nlohmann::json& json_test, std::optional<ChainConfi
     init_pre_state(json_test["pre"], state);
 
     Blockchain blockchain{state, config, genesis_block};
+    blockchain.sender_cache = &sender_cache;
 
     for (const auto& json_block : json_test["blocks"]) {
         Status status{run_block(json_block, blockchain)};
@@ -585,6 +590,8 @@ int main() {
         std::cout << "\033[0m";
     }
     std::cout << ", " << res.skipped << " skipped\n";
+    std::cout << sender_cache.hits() << " of " << sender_cache.hits() + sender_cache.misses()
+              << " sender recoveries avoided by the cache\n";
 
     return static_cast<int>(res.failed);
 }
@@ -26,6 +26,7 @@
 #include <silkworm/db/chaindb.hpp>
 #include <silkworm/db/tables.hpp>
 #include <silkworm/db/util.hpp>
+#include <silkworm/rlp/index.hpp>
 #include <silkworm/types/block.hpp>
 #include <string>
 
@@ -444,6 +445,67 @@ int do_stages(db_options_t& db_opts) {
     return retvar;
 }
 
+// Whether a record is a single list of the expected number of elements
+static bool is_valid_record(rlp::StructuralIndex& index, ByteView record, size_t num_elements) {
+    return index.build(record) == rlp::DecodingResult::kOk && index.size() && index[0].list &&
+           index[0].end == index.size() && index.num_children(0) == num_elements;
+}
+
+int do_rlp(db_options_t& db_opts) {
+
+    static std::string fmt_hdr{" %-24s %12s %12s "};
+    static std::string fmt_row{" %-24s %12u %12u "};
+
+    int retvar{0};
+    std::shared_ptr<lmdb::Environment> lmdb_env{open_db(db_opts, true)};  // Main lmdb environment
+
+    try {
+
+        if (!lmdb_env) throw std::runtime_error("Could not open LMDB environment");
+        auto lmdb_txn{lmdb_env->begin_ro_transaction()};
+
+        std::cout << "\n" << (boost::format(fmt_hdr) % "Table name" % "Records" % "Invalid") << std::endl;
+        std::cout << (boost::format(fmt_hdr) % std::string(24, '-') % std::string(12, '-') % std::string(12, '-'))
+                  << std::endl;
+
+        // Stored block bodies are [base_txn_id, txn_count, ommers], transactions have 9 fields
+        const std::pair<lmdb::TableConfig, size_t> tables[]{{db::table::kBlockBodies, 3}, {db::table::kEthTx, 9}};
+        rlp::StructuralIndex index;
+        for (const auto& [config, num_elements] : tables) {
+            auto table{lmdb_txn->open(config)};
+            size_t records{0};
+            size_t invalid{0};
+
+            MDB_val key, data;
+            int rc{table->get_first(&key, &data)};
+            while (rc == MDB_SUCCESS && !shouldStop) {
+                ++records;
+                if (!is_valid_record(index, db::from_mdb_val(data), num_elements)) {
+                    if (++invalid <= 10) {
+                        std::cout << " Invalid record in " << config.name << " : " << to_hex(db::from_mdb_val(key))
+                                  << std::endl;
+                    }
+                }
+                rc = table->get_next(&key, &data);
+            }
+            if (rc != MDB_SUCCESS && rc != MDB_NOTFOUND) lmdb::err_handler(rc);
+
+            std::cout << (boost::format(fmt_row) % config.name % records % invalid) << std::endl;
+            if (invalid) retvar = -1;
+        }
+
+    } catch (lmdb::exception& ex) {
+        std::cout << ex.err() << " " << ex.what() << std::endl;
+        retvar = -1;
+    } catch (std::runtime_error& ex) {
+        std::cout << ex.what() << std::endl;
+        retvar = -1;
+    }
+
+    lmdb_env.reset();
+    return retvar;
+}
+
 int do_tables(db_options_t& db_opts) {
 
     static std::string fmt_hdr{" %3s %-24s %10s %2s %10s %10s %10s %12s"};
@@ -840,6 +902,9 @@ int main(int argc, char* argv[]) {
     // List stages keys and their heights
     auto& app_stages = *app_main.add_subcommand("stages", "List stages and their actual heights");
 
+    // Validates the RLP of stored block bodies & transactions
+    auto& app_rlp = *app_main.add_subcommand("rlp", "Validates RLP of block bodies and transactions");
+
     CLI11_PARSE(app_main, argc, argv);
 
     // Check provided data file exists
@@ -909,6 +974,8 @@ int main(int argc, char* argv[]) {
         return do_scan(db_opts);
     } else if (app_stages) {
         return do_stages(db_opts);
+    } else if (app_rlp) {
+        return do_rlp(db_opts);
     } else if (app_freelist) {
         return do_freelist(db_opts, freelist_opts);
     } else if (app_clear) {
@@ -62,6 +62,7 @@ int main(int argc, char* argv[]) {
 
     AnalysisCache analysis_cache;
     ExecutionStatePool state_pool;
+    PrecompileCache precompile_cache;
 
     try {
         // counters
@@ -82,7 +83,8 @@ int main(int argc, char* argv[]) {
             db::Buffer buffer{txn.get(), block_num};
 
             // Execute the block and retreive the receipts
-            auto [receipts, err]{execute_block(bh->block, buffer, kMainnetConfig, &analysis_cache, &state_pool)};
+            auto [receipts, err]{
+                execute_block(bh->block, buffer, kMainnetConfig, &analysis_cache, &state_pool, &precompile_cache)};
             if (err != ValidationResult::kOk) {
                 std::cerr << "Validation error " << static_cast<int>(err) << " at block " << block_num << "\n";
             }
@@ -123,6 +125,8 @@ int main(int argc, char* argv[]) {
         retvar = -1;
     }
 
+    precompile_cache.report(std::cout);
+
     // Note: See notes above. Even though this will go out of scope and automatically clean up, you may
     // uncomment this if you're using the long-lived database transaction noted above.
     // txn.reset();
@@ -17,21 +17,49 @@
 #include <CLI/CLI.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <iostream>
 #include <silkworm/common/log.hpp>
 #include <silkworm/db/access_layer.hpp>
 #include <silkworm/db/stages.hpp>
 #include <silkworm/db/tables.hpp>
-#include <silkworm/etl/collector.hpp>
+#include <silkworm/db/tx_lookup.hpp>
+#include <silkworm/etl/sharded_collector.hpp>
+#include <thread>
+#include <vector>
 
 using namespace silkworm;
 
-static Bytes compact(Bytes& b) {
-    std::string::size_type offset{b.find_first_not_of((uint8_t)0)};
-    if (offset != std::string::npos) {
-        return b.substr(offset);
+static unsigned get_host_cpus() {
+    unsigned n{std::thread::hardware_concurrency()};
+    return n ? n : 2;
+}
+
+static int64_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * The ETL path pays a fixed cost (work dir, threads, ro transactions, manifest) which only
+ * its parallel extraction can pay back. benchmark_tx_lookup measures both paths : the fixed
+ * cost is about 3 ms while extracting a block of 150 transactions takes about 0.15 ms
+ */
+constexpr uint64_t kEtlFixedCostUs{3'000};
+constexpr uint64_t kBlockExtractionUs{150};
+
+/*
+ * Below this number of new blocks the sorted batch is built in memory and merged
+ * directly into tx lookup table : with T threads the ETL path only wins above
+ * 3 / (0.15 * (1 - 1/T)) blocks, i.e. 40 blocks for 2 threads and 23 for 8, and never with 1.
+ * Tune with --incremental-max-blocks on hosts which differ
+ */
+static uint64_t default_incremental_max_blocks(uint32_t numthreads) {
+    if (numthreads <= 1) {
+        return UINT64_MAX;
     }
-    return b;
+    const uint64_t dividend{kEtlFixedCostUs * numthreads};
+    const uint64_t divisor{kBlockExtractionUs * (numthreads - 1)};
+    return (dividend + divisor - 1) / divisor;
 }
 
 int main(int argc, char* argv[]) {
@@ -41,12 +69,21 @@ int main(int argc, char* argv[]) {
 
     std::string db_path{db::default_path()};
     bool full;
+    uint32_t numthreads{get_host_cpus()};
+    uint64_t incremental_max_blocks{0};
     app.add_option("-d,--datadir", db_path, "Path to a database populated by Turbo-Geth", true)
         ->check(CLI::ExistingDirectory);
 
     app.add_flag("--full", full, "Start making lookups from block 0");
+    app.add_option("--incremental-max-blocks", incremental_max_blocks,
+                   "Max number of new blocks merged directly in memory bypassing ETL (0 disables, "
+                   "default depends on threads)");
+    app.add_option("--threads", numthreads, "Number of extraction threads", true)
+        ->check(CLI::Range(1u, get_host_cpus()));
     CLI11_PARSE(app, argc, argv);
-
+    if (!app.count("--incremental-max-blocks")) {
+        incremental_max_blocks = default_incremental_max_blocks(numthreads);
+    }
 
     // Check data.mdb exists in provided directory
     boost::filesystem::path db_file{boost::filesystem::path(db_path) / boost::filesystem::path("data.mdb")};
@@ -54,18 +91,15 @@ int main(int argc, char* argv[]) {
         SILKWORM_LOG(LogError) << "Can't find a valid TG data file in " << db_path << std::endl;
         return -1;
     }
-    fs::path datadir(db_path);
-    fs::path etl_path(datadir.parent_path() / fs::path("etl-temp"));
+    fs::path etl_path(db::tx_lookup::etl_work_path(db_path));
     fs::create_directories(etl_path);
-    etl::Collector collector(etl_path.string().c_str(), /* flush size */ 512 * kMebi);
 
     lmdb::DatabaseConfig db_config{db_path};
     db_config.set_readonly(false);
     std::shared_ptr<lmdb::Environment> env{lmdb::get_env(db_config)};
     std::unique_ptr<lmdb::Transaction> txn{env->begin_rw_transaction()};
-    // We take data from header table and transform it and put it in blockhashes table
+    // We take data from bodies and transactions tables and transform it and put it in tx lookup table
     auto bodies_table{txn->open(db::table::kBlockBodies)};
-    auto transactions_table{txn->open(db::table::kEthTx)};
 
     try {
         auto last_processed_block_number{db::stages::get_stage_progress(*txn, db::stages::kTxLookupKey)};
@@ -74,49 +108,68 @@ int main(int argc, char* argv[]) {
         }
         uint64_t block_number{0};
 
-        // Extract
-        Bytes start(8, '\0');
-        boost::endian::store_big_u64(&start[0], last_processed_block_number + 1);
-        MDB_val mdb_key{db::to_mdb_val(start)};
-        MDB_val mdb_data;
-        SILKWORM_LOG(LogInfo) << "Started Tx Lookup Extraction" << std::endl;
-        int rc{bodies_table->seek(&mdb_key, &mdb_data)};  // Sets cursor to nearest key greater equal than this
-        while (!rc) {                                     /* Loop as long as we have no errors*/
-            auto body_rlp{db::from_mdb_val(mdb_data)};
-            auto body{db::detail::decode_stored_block_body(body_rlp)};
-            Bytes block_number_as_bytes(static_cast<unsigned char*>(mdb_key.mv_data), 8);
-            auto lookup_block_data{compact(block_number_as_bytes)};
-            block_number = boost::endian::load_big_u64(&block_number_as_bytes[0]);
-            if (body.txn_count > 0) {
-                Bytes transaction_key(8, '\0');
-                boost::endian::store_big_u64(transaction_key.data(), body.base_txn_id);
-                MDB_val tx_key_mdb{db::to_mdb_val(transaction_key)};
-                MDB_val tx_data_mdb{};
-
-                uint64_t i{0};
-                for (rc = transactions_table->seek_exact(&tx_key_mdb, &tx_data_mdb);
-                     rc != MDB_NOTFOUND && i < body.txn_count;
-                     rc = transactions_table->get_next(&tx_key_mdb, &tx_data_mdb), ++i) {
-                    lmdb::err_handler(rc);
-                    // Take transaction rlp, then hash it in order to get the transaction hash
-                    ByteView tx_rlp{db::from_mdb_val(tx_data_mdb)};
-                    auto hash{keccak256(tx_rlp)};
-                    etl::Entry entry{Bytes(hash.bytes, 32), Bytes(lookup_block_data.data(), lookup_block_data.size())};
-                    collector.collect(entry);
-                }
-            }
-            // Save last processed block_number and expect next in sequence
-            if (block_number % 100000 == 0) {
-                SILKWORM_LOG(LogInfo) << "Tx Lookup Extraction Progress << " << block_number << std::endl;
+        // Locate the highest block body available
+        MDB_val mdb_key, mdb_data;
+        int rc{bodies_table->get_last(&mdb_key, &mdb_data)};
+        if (rc && rc != MDB_NOTFOUND) {
+            lmdb::err_handler(rc);
+        }
+        uint64_t from{last_processed_block_number + 1};
+        uint64_t to{rc ? 0 : boost::endian::load_big_u64(static_cast<uint8_t*>(mdb_key.mv_data))};
+
+        auto start_time{std::chrono::steady_clock::now()};
+
+        // Few new blocks (e.g. node applying a handful of blocks at a time) : merge in memory
+        if (!full && to >= from && to - from < incremental_max_blocks &&
+            !etl::read_manifest(etl_path.string()).has_value()) {
+            SILKWORM_LOG(LogInfo) << "Started Incremental Tx Lookup (" << (to - from + 1) << " blocks)" << std::endl;
+            auto count{db::tx_lookup::merge_tx_hashes(*txn, from, to)};
+            db::stages::set_stage_progress(*txn, db::stages::kTxLookupKey, to);
+            lmdb::err_handler(txn->commit());
+            SILKWORM_LOG(LogInfo) << "Incremental Tx Lookup merged " << count << " entries in "
+                                  << elapsed_ms(start_time) << " ms" << std::endl;
+            SILKWORM_LOG(LogInfo) << "All Done" << std::endl;
+            return 0;
+        }
+
+        // Resume from a previous interrupted run (if any) provided its partitions
+        // start exactly where the stage progress is
+        std::vector<db::tx_lookup::Partition> partitions;
+        auto manifest{etl::read_manifest(etl_path.string())};
+        if (manifest.has_value() && !full) {
+            partitions = db::tx_lookup::resumable_partitions(manifest->cursors, from, to);
+            if (!partitions.empty()) {
+                numthreads = partitions.size();
+                to = partitions.back().to;
             }
-            rc = bodies_table->get_next(&mdb_key, &mdb_data);
+        }
+        if (partitions.empty()) {
+            etl::remove_manifest(etl_path.string());
         }
 
-        if (rc && rc != MDB_NOTFOUND) { /* MDB_NOTFOUND is not actually an error rather eof */
-            lmdb::err_handler(rc);
+        etl::ShardedCollector collector(numthreads, etl_path.string().c_str(), /* flush size */ 512 * kMebi);
+        if (collector.restore().has_value()) {
+            SILKWORM_LOG(LogInfo) << "Resuming Tx Lookup Extraction with " << collector.size()
+                                  << " entries already collected" << std::endl;
+        } else {
+            partitions.clear();
+        }
+        if (partitions.empty() && to >= from) {
+            // Split the block range into contiguous partitions each processed by a
+            // dedicated thread (with its own ro transaction) collecting into its own shard
+            partitions = db::tx_lookup::split_by_txn_count(*bodies_table, from, to, numthreads);
+        }
+
+        // Extract
+        if (!partitions.empty()) {
+            SILKWORM_LOG(LogInfo) << "Started Tx Lookup Extraction (" << partitions.size() << " threads)"
+                                  << std::endl;
+            db::tx_lookup::collect_tx_hashes(*env, partitions, collector);
+            block_number = to;
         }
 
-        SILKWORM_LOG(LogInfo) << "Entries Collected << " << collector.size() << std::endl;
+        const auto overall_size{collector.size()};
+        SILKWORM_LOG(LogInfo) << "Entries Collected << " << overall_size << std::endl;
 
         // Proceed only if we've done something
         if (collector.size()) {
@@ -142,6 +195,8 @@ int main(int argc, char* argv[]) {
             // Update progress height with last processed block
             db::stages::set_stage_progress(*txn, db::stages::kTxLookupKey, block_number);
             lmdb::err_handler(txn->commit());
+            SILKWORM_LOG(LogInfo) << "ETL Tx Lookup loaded " << overall_size << " entries in "
+                                  << elapsed_ms(start_time) << " ms" << std::endl;
 
         } else {
             SILKWORM_LOG(LogInfo) << "Nothing to process" << std::endl;
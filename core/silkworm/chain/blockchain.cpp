@@ -16,11 +16,20 @@
 
 #include "blockchain.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <silkworm/execution/execution.hpp>
 
 namespace silkworm {
 
+// Bodies read back from the state may or may not carry the senders, depending on the buffer
+static void recover_missing_senders(Block& block, const ChainConfig& config, SenderCache* sender_cache) {
+    if (std::any_of(block.transactions.begin(), block.transactions.end(),
+                    [](const Transaction& txn) { return !txn.from; })) {
+        block.recover_senders(config, sender_cache);
+    }
+}
+
 Blockchain::Blockchain(StateBuffer& state, const ChainConfig& config, const Block& genesis_block)
     : state_{state}, config_{config} {
     evmc::bytes32 hash{genesis_block.header.hash()};
@@ -29,7 +38,8 @@ Blockchain::Blockchain(StateBuffer& state, const ChainConfig& config, const Bloc
 }
 
 ValidationResult Blockchain::insert_block(Block& block, bool check_state_root) {
-    if (ValidationResult err{pre_validate_block(block, state_, config_)}; err != ValidationResult::kOk) {
+    if (ValidationResult err{pre_validate_block(block, state_, config_, ethash_epochs)};
+        err != ValidationResult::kOk) {
         return err;
     }
 
@@ -38,7 +48,7 @@ ValidationResult Blockchain::insert_block(Block& block, bool check_state_root) {
         return it->second;
     }
 
-    block.recover_senders(config_);
+    block.recover_senders(config_, sender_cache);
 
     uint64_t ancestor{canonical_ancestor(block.header, hash)};
     uint64_t current_canonical_block{state_.current_canonical_block()};
@@ -115,6 +125,7 @@ void Blockchain::re_execute_canonical_chain(uint64_t ancestor, uint64_t tip) {
         block.header = *header;
         block.transactions = body->transactions;
         block.ommers = body->ommers;
+        recover_missing_senders(block, config_, sender_cache);
 
         [[maybe_unused]] ValidationResult err{execute_block(block, /*check_state_root=*/false)};
         assert(err == ValidationResult::kOk);
@@ -140,6 +151,7 @@ std::vector<BlockWithHash> Blockchain::intermediate_chain(uint64_t block_number,
         x.block.header = *header;
         x.block.transactions = body->transactions;
         x.block.ommers = body->ommers;
+        recover_missing_senders(x.block, config_, sender_cache);
         x.hash = hash;
 
         hash = header->parent_hash;
@@ -33,6 +33,13 @@ class Blockchain {
 
     ValidationResult insert_block(Block& block, bool check_state_root);
 
+    // Senders missing from bodies read back are recovered again whenever blocks are re-executed,
+    // so use for better performance
+    SenderCache* sender_cache{nullptr};
+
+    // Proof of work isn't verified without
+    EthashEpochManager* ethash_epochs{nullptr};
+
   private:
     ValidationResult execute_block(const Block& block, bool check_state_root);
 
@@ -0,0 +1,179 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "ethash.hpp"
+
+#include <cstring>
+#include <ethash/keccak.hpp>
+#include <intx/intx.hpp>
+
+namespace silkworm {
+
+// Hashes are processed as little-endian 32-bit words
+static constexpr uint64_t kCacheBytesInit{1u << 24};
+static constexpr uint64_t kCacheBytesGrowth{1u << 17};
+static constexpr uint64_t kDatasetBytesInit{1u << 30};
+static constexpr uint64_t kDatasetBytesGrowth{1u << 23};
+static constexpr uint64_t kHashBytes{64};
+static constexpr uint64_t kMixBytes{128};
+static constexpr size_t kCacheRounds{3};
+static constexpr uint32_t kDatasetParents{256};
+static constexpr uint32_t kAccesses{64};
+
+static constexpr size_t kHashWords{kHashBytes / 4};
+static constexpr size_t kMixWords{kMixBytes / 4};
+
+static bool is_prime(uint64_t n) noexcept {
+    if (n < 2 || n % 2 == 0) {
+        return n == 2;
+    }
+    for (uint64_t d{3}; d * d <= n; d += 2) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Largest prime number of items that fits into init + growth * epoch bytes minus one item
+static uint64_t num_items(uint64_t init, uint64_t growth, uint64_t item_size, uint64_t epoch_number) noexcept {
+    uint64_t n{(init + growth * epoch_number) / item_size - 1};
+    while (!is_prime(n)) {
+        n -= 2;
+    }
+    return n;
+}
+
+static inline uint32_t fnv(uint32_t u, uint32_t v) noexcept { return (u * 0x01000193) ^ v; }
+
+std::shared_ptr<const EthashEpoch> create_ethash_epoch(uint64_t epoch_number) {
+    auto epoch{std::make_shared<EthashEpoch>()};
+    epoch->number = epoch_number;
+    epoch->full_dataset_num_pages =
+        static_cast<uint32_t>(num_items(kDatasetBytesInit, kDatasetBytesGrowth, kMixBytes, epoch_number));
+
+    ethash::hash256 seed{};
+    for (uint64_t i{0}; i < epoch_number; ++i) {
+        seed = ethash::keccak256(seed);
+    }
+
+    std::vector<ethash::hash512>& cache{epoch->light_cache};
+    cache.resize(num_items(kCacheBytesInit, kCacheBytesGrowth, kHashBytes, epoch_number));
+    const size_t n{cache.size()};
+    cache[0] = ethash::keccak512(seed.bytes, sizeof(seed.bytes));
+    for (size_t i{1}; i < n; ++i) {
+        cache[i] = ethash::keccak512(cache[i - 1]);
+    }
+
+    // RandMemoHash
+    for (size_t round{0}; round < kCacheRounds; ++round) {
+        for (size_t i{0}; i < n; ++i) {
+            const ethash::hash512& a{cache[(i + n - 1) % n]};
+            const ethash::hash512& b{cache[cache[i].word32s[0] % n]};
+            ethash::hash512 x;
+            for (size_t j{0}; j < 8; ++j) {
+                x.word64s[j] = a.word64s[j] ^ b.word64s[j];
+            }
+            cache[i] = ethash::keccak512(x);
+        }
+    }
+
+    return epoch;
+}
+
+// Item of the full dataset
+static ethash::hash512 dataset_item(const std::vector<ethash::hash512>& cache, uint32_t index) noexcept {
+    const auto n{static_cast<uint32_t>(cache.size())};
+    ethash::hash512 mix{cache[index % n]};
+    mix.word32s[0] ^= index;
+    mix = ethash::keccak512(mix);
+    for (uint32_t j{0}; j < kDatasetParents; ++j) {
+        const ethash::hash512& parent{cache[fnv(index ^ j, mix.word32s[j % kHashWords]) % n]};
+        for (size_t k{0}; k < kHashWords; ++k) {
+            mix.word32s[k] = fnv(mix.word32s[k], parent.word32s[k]);
+        }
+    }
+    return ethash::keccak512(mix);
+}
+
+EthashResult hashimoto_light(const EthashEpoch& epoch, const evmc::bytes32& header_hash, uint64_t nonce) noexcept {
+    uint8_t seed_input[kHashLength + 8];
+    std::memcpy(seed_input, header_hash.bytes, kHashLength);
+    for (size_t i{0}; i < 8; ++i) {
+        seed_input[kHashLength + i] = static_cast<uint8_t>(nonce >> (8 * i));
+    }
+    const ethash::hash512 seed{ethash::keccak512(seed_input, sizeof(seed_input))};
+
+    uint32_t mix[kMixWords];
+    for (size_t i{0}; i < kMixWords; ++i) {
+        mix[i] = seed.word32s[i % kHashWords];
+    }
+    for (uint32_t i{0}; i < kAccesses; ++i) {
+        const uint32_t page{fnv(i ^ seed.word32s[0], mix[i % kMixWords]) % epoch.full_dataset_num_pages};
+        for (uint32_t half{0}; half < 2; ++half) {
+            const ethash::hash512 item{dataset_item(epoch.light_cache, page * 2 + half)};
+            for (size_t k{0}; k < kHashWords; ++k) {
+                mix[half * kHashWords + k] = fnv(mix[half * kHashWords + k], item.word32s[k]);
+            }
+        }
+    }
+
+    // Compressed mix
+    uint32_t cmix[kMixWords / 4];
+    for (size_t i{0}; i < kMixWords / 4; ++i) {
+        cmix[i] = fnv(fnv(fnv(mix[4 * i], mix[4 * i + 1]), mix[4 * i + 2]), mix[4 * i + 3]);
+    }
+
+    EthashResult res;
+    std::memcpy(res.mix_hash.bytes, cmix, kHashLength);
+
+    uint8_t final_input[kHashBytes + kHashLength];
+    std::memcpy(final_input, seed.bytes, kHashBytes);
+    std::memcpy(&final_input[kHashBytes], cmix, kHashLength);
+    const ethash::hash256 final_hash{ethash::keccak256(final_input, sizeof(final_input))};
+    std::memcpy(res.final_hash.bytes, final_hash.bytes, kHashLength);
+
+    return res;
+}
+
+bool verify_ethash(const EthashEpoch& epoch, const BlockHeader& header) {
+    if (header.difficulty == 0) {
+        return false;
+    }
+
+    uint64_t nonce{0};
+    for (uint8_t b : header.nonce) {
+        nonce = (nonce << 8) | b;
+    }
+    const EthashResult res{hashimoto_light(epoch, header.hash(/*for_sealing=*/true), nonce)};
+    if (res.mix_hash != header.mix_hash) {
+        return false;
+    }
+
+    // final_hash ≤ 2^256 / difficulty, which only overflows 256 bits for a difficulty of 1
+    if (header.difficulty == 1) {
+        return true;
+    }
+    const intx::uint256 max{~intx::uint256{0}};  // 2^256 - 1
+    intx::uint256 boundary{max / header.difficulty};
+    if (max % header.difficulty == header.difficulty - 1) {
+        ++boundary;  // the difficulty divides 2^256
+    }
+    return intx::be::unsafe::load<intx::uint256>(res.final_hash.bytes) <= boundary;
+}
+
+}  // namespace silkworm
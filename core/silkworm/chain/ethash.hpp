@@ -0,0 +1,58 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#ifndef SILKWORM_CHAIN_ETHASH_H_
+#define SILKWORM_CHAIN_ETHASH_H_
+
+#include <ethash/hash_types.hpp>
+#include <memory>
+#include <silkworm/types/block.hpp>
+#include <vector>
+
+// Ethash, the proof of work of Ethereum, verified from the light cache.
+// See [YP] Appendix J "Ethash" and https://eth.wiki/en/concepts/ethash/ethash
+
+namespace silkworm {
+
+constexpr uint64_t kEthashEpochLength{30'000};
+
+// What verifying the proof of work of the blocks of an epoch takes
+struct EthashEpoch {
+    uint64_t number{0};
+    std::vector<ethash::hash512> light_cache;
+    uint32_t full_dataset_num_pages{0};  // of 128 bytes, i.e. two dataset items
+};
+
+// Builds the light cache of an epoch, which takes about a second
+std::shared_ptr<const EthashEpoch> create_ethash_epoch(uint64_t epoch_number);
+
+struct EthashResult {
+    evmc::bytes32 mix_hash;
+    evmc::bytes32 final_hash;
+};
+
+// Hashimoto with the dataset items derived from the light cache on demand.
+// header_hash is BlockHeader::hash for sealing.
+EthashResult hashimoto_light(const EthashEpoch& epoch, const evmc::bytes32& header_hash, uint64_t nonce) noexcept;
+
+// Whether the mix hash & nonce of the header prove the work its difficulty calls for.
+// The epoch must be that of the header.
+bool verify_ethash(const EthashEpoch& epoch, const BlockHeader& header);
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_CHAIN_ETHASH_H_
@@ -0,0 +1,88 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "ethash_epochs.hpp"
+
+#include <optional>
+
+namespace silkworm {
+
+EthashEpochManager::EthashEpochManager() : prebuilder_{[this] { prebuild_loop(); }} {}
+
+EthashEpochManager::~EthashEpochManager() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    prebuild_cv_.notify_one();
+    prebuilder_.join();
+}
+
+std::shared_ptr<const EthashEpoch> EthashEpochManager::get(uint64_t block_number) {
+    const uint64_t number{block_number / kEthashEpochLength};
+
+    EpochFuture future;
+    std::optional<EpochPromise> to_build;
+    {
+        std::lock_guard lock{mutex_};
+
+        // Only the previous epoch is kept for blocks behind, e.g. ommers
+        epochs_.erase(epochs_.begin(), epochs_.lower_bound(number > 0 ? number - 1 : 0));
+
+        auto it{epochs_.find(number)};
+        if (it == epochs_.end()) {
+            to_build.emplace();
+            it = epochs_.emplace(number, to_build->get_future().share()).first;
+        }
+        future = it->second;
+
+        if (epochs_.find(number + 1) == epochs_.end()) {
+            EpochPromise next;
+            epochs_.emplace(number + 1, next.get_future().share());
+            prebuild_queue_.emplace_back(number + 1, std::move(next));
+            prebuild_cv_.notify_one();
+        }
+    }
+
+    if (to_build) {
+        to_build->set_value(create_ethash_epoch(number));
+    }
+    return future.get();
+}
+
+void EthashEpochManager::prebuild_loop() {
+    std::unique_lock lock{mutex_};
+    while (true) {
+        prebuild_cv_.wait(lock, [this] { return stopping_ || !prebuild_queue_.empty(); });
+        if (stopping_) {
+            break;
+        }
+        auto [number, promise]{std::move(prebuild_queue_.front())};
+        prebuild_queue_.pop_front();
+
+        lock.unlock();
+        promise.set_value(create_ethash_epoch(number));
+        lock.lock();
+    }
+
+    // Nobody waits for the epochs that weren't built
+    for (auto& [number, promise] : prebuild_queue_) {
+        promise.set_value(nullptr);
+    }
+}
+
+}  // namespace silkworm
@@ -0,0 +1,65 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#ifndef SILKWORM_CHAIN_ETHASH_EPOCHS_H_
+#define SILKWORM_CHAIN_ETHASH_EPOCHS_H_
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <silkworm/chain/ethash.hpp>
+#include <thread>
+#include <utility>
+
+// Only built with SILKWORM_CORE_THREADS
+
+namespace silkworm {
+
+// Keeps the epochs around the latest one asked for, building the following one
+// ahead of time on a background thread so that verification doesn't stall at epoch boundaries.
+// The manager may be shared between threads.
+class EthashEpochManager {
+  public:
+    EthashEpochManager();
+    ~EthashEpochManager();
+
+    EthashEpochManager(const EthashEpochManager&) = delete;
+    EthashEpochManager& operator=(const EthashEpochManager&) = delete;
+
+    // Epoch of the block; built on the spot unless it's available or being built already
+    std::shared_ptr<const EthashEpoch> get(uint64_t block_number);
+
+  private:
+    using EpochFuture = std::shared_future<std::shared_ptr<const EthashEpoch>>;
+    using EpochPromise = std::promise<std::shared_ptr<const EthashEpoch>>;
+
+    void prebuild_loop();
+
+    std::mutex mutex_;
+    std::map<uint64_t, EpochFuture> epochs_;
+    std::deque<std::pair<uint64_t, EpochPromise>> prebuild_queue_;
+    std::condition_variable prebuild_cv_;
+    bool stopping_{false};
+    std::thread prebuilder_;
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_CHAIN_ETHASH_EPOCHS_H_
@@ -0,0 +1,39 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "ethash_epochs.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Ethash epoch manager") {
+    EthashEpochManager manager;
+    const std::shared_ptr<const EthashEpoch> epoch{manager.get(1)};
+    REQUIRE(epoch);
+    CHECK(epoch->number == 0);
+    CHECK(epoch->light_cache.size() == 262'139);
+    CHECK(manager.get(kEthashEpochLength - 1) == epoch);
+
+    // Built ahead of time
+    const std::shared_ptr<const EthashEpoch> next{manager.get(kEthashEpochLength)};
+    REQUIRE(next);
+    CHECK(next->number == 1);
+    CHECK(manager.get(kEthashEpochLength - 1) == epoch);
+}
+
+}  // namespace silkworm
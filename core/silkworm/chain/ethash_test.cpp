@@ -0,0 +1,81 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "ethash.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/endian.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/decode.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Ethash") {
+    // Mainnet block 1
+    const Bytes rlp{*from_hex(
+        "f90211a0d4e56740f876aef8c010b86a40d5f56745a118d0906a34e69aec8c0db1cb8fa3a01dcc4de8dec75d7aab85b567b6"
+        "ccd41ad312451b948a7413f0a142fd40d493479405a56e2d52c817161883f50c441c3228cfe54d9fa0d67e4d450343046425"
+        "ae4271474353857ab860dbc0a1dde64b41b5cd3a532bf3a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc00162"
+        "2fb5e363b421a056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b901000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000008503"
+        "ff80000001821388808455ba422499476574682f76312e302e302f6c696e75782f676f312e342e32a0969b900de27b6ac6a6"
+        "7742365dd65f55a0526c41fd18e1b16f1a1215c2e66f5988539bd4979fef1ec4")};
+    ByteView view{rlp};
+    BlockHeader header;
+    REQUIRE(rlp::decode(view, header) == rlp::DecodingResult::kOk);
+    CHECK(to_hex(header.hash()) == "88e96d4537bea4d9c05d12549907b32561d3bf31f45aae734cdc119f13406cb6");
+
+    const std::shared_ptr<const EthashEpoch> epoch{create_ethash_epoch(header.number / kEthashEpochLength)};
+    REQUIRE(epoch);
+    CHECK(epoch->number == 0);
+    CHECK(epoch->light_cache.size() == 262'139);
+    CHECK(epoch->full_dataset_num_pages == 8'388'593);
+
+    CHECK(verify_ethash(*epoch, header));
+
+    BlockHeader wrong_nonce{header};
+    wrong_nonce.nonce[7] ^= 1;
+    CHECK(!verify_ethash(*epoch, wrong_nonce));
+
+    BlockHeader wrong_mix_hash{header};
+    wrong_mix_hash.mix_hash.bytes[0] ^= 1;
+    CHECK(!verify_ethash(*epoch, wrong_mix_hash));
+
+    // Right mix hash, but not enough work for that difficulty
+    const uint64_t nonce{endian::load_big_u64(header.nonce.data())};
+    BlockHeader harder{header};
+    harder.difficulty = intx::uint256{1} << 128;
+    harder.mix_hash = hashimoto_light(*epoch, harder.hash(/*for_sealing=*/true), nonce).mix_hash;
+    CHECK(!verify_ethash(*epoch, harder));
+
+    // Any final hash is below 2^256 / 1 and 2^256 / 2^255 = 2, but for the mix hash
+    for (const intx::uint256& difficulty : {intx::uint256{1}, intx::uint256{2}}) {
+        BlockHeader easiest{header};
+        easiest.difficulty = difficulty;
+        const EthashResult res{hashimoto_light(*epoch, easiest.hash(/*for_sealing=*/true), nonce)};
+        easiest.mix_hash = res.mix_hash;
+        CHECK(verify_ethash(*epoch, easiest) == (difficulty == 1 || res.final_hash.bytes[0] < 0x80));
+        easiest.mix_hash.bytes[0] ^= 1;
+        CHECK(!verify_ethash(*epoch, easiest));
+    }
+}
+
+}  // namespace silkworm
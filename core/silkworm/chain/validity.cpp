@@ -16,8 +16,14 @@
 
 #include "validity.hpp"
 
+#include <atomic>
+#include <silkworm/common/parallel_for_each.hpp>
 #include <silkworm/trie/vector_root.hpp>
 
+#ifdef SILKWORM_CORE_THREADS
+#include <silkworm/chain/ethash_epochs.hpp>
+#endif
+
 #include "difficulty.hpp"
 
 namespace silkworm {
@@ -26,9 +32,8 @@ static std::optional<BlockHeader> get_parent(const StateBuffer& state, const Blo
     return state.read_header(header.number - 1, header.parent_hash);
 }
 
-ValidationResult validate_block_header(const BlockHeader& header, const StateBuffer& state, const ChainConfig& config) {
-    // TODO[Issue 144] Ethash PoW verification
-
+// Checks that don't involve the parent
+static ValidationResult validate_gas(const BlockHeader& header) {
     if (header.gas_used > header.gas_limit) {
         return ValidationResult::kGasAboveLimit;
     }
@@ -43,24 +48,25 @@ ValidationResult validate_block_header(const BlockHeader& header, const StateBuf
         return ValidationResult::kInvalidGasLimit;
     }
 
-    std::optional<BlockHeader> parent{get_parent(state, header)};
-    if (!parent) {
-        return ValidationResult::kUnknownParent;
-    }
+    return ValidationResult::kOk;
+}
 
-    if (header.timestamp <= parent->timestamp) {
+static ValidationResult validate_against_parent(const BlockHeader& header, const BlockHeader& parent,
+                                                const ChainConfig& config,
+                                                [[maybe_unused]] EthashEpochManager* ethash_epochs) {
+    if (header.timestamp <= parent.timestamp) {
         return ValidationResult::kInvalidTimestamp;
     }
 
-    uint64_t gas_delta{header.gas_limit > parent->gas_limit ? header.gas_limit - parent->gas_limit
-                                                            : parent->gas_limit - header.gas_limit};
-    if (gas_delta >= parent->gas_limit / 1024) {
+    uint64_t gas_delta{header.gas_limit > parent.gas_limit ? header.gas_limit - parent.gas_limit
+                                                           : parent.gas_limit - header.gas_limit};
+    if (gas_delta >= parent.gas_limit / 1024) {
         return ValidationResult::kInvalidGasLimit;
     }
 
-    bool parent_has_uncles{parent->ommers_hash != kEmptyListHash};
-    intx::uint256 difficulty{canonical_difficulty(header.number, header.timestamp, parent->difficulty,
-                                                  parent->timestamp, parent_has_uncles, config)};
+    bool parent_has_uncles{parent.ommers_hash != kEmptyListHash};
+    intx::uint256 difficulty{canonical_difficulty(header.number, header.timestamp, parent.difficulty,
+                                                  parent.timestamp, parent_has_uncles, config)};
     if (difficulty != header.difficulty) {
         return ValidationResult::kWrongDifficulty;
     }
@@ -73,9 +79,71 @@ ValidationResult validate_block_header(const BlockHeader& header, const StateBuf
         }
     }
 
+#ifdef SILKWORM_CORE_THREADS
+    // Last as the most expensive check
+    if (ethash_epochs && !verify_ethash(*ethash_epochs->get(header.number), header)) {
+        return ValidationResult::kInvalidSeal;
+    }
+#endif
+
     return ValidationResult::kOk;
 }
 
+ValidationResult validate_block_header(const BlockHeader& header, const StateBuffer& state, const ChainConfig& config,
+                                       EthashEpochManager* ethash_epochs) {
+    if (ValidationResult err{validate_gas(header)}; err != ValidationResult::kOk) {
+        return err;
+    }
+
+    std::optional<BlockHeader> parent{get_parent(state, header)};
+    if (!parent) {
+        return ValidationResult::kUnknownParent;
+    }
+
+    return validate_against_parent(header, *parent, config, ethash_epochs);
+}
+
+ValidationResult validate_block_header(const BlockHeader& header, const BlockHeader& parent, const ChainConfig& config,
+                                       EthashEpochManager* ethash_epochs) {
+    if (ValidationResult err{validate_gas(header)}; err != ValidationResult::kOk) {
+        return err;
+    }
+
+    if (header.number != parent.number + 1 || header.parent_hash != parent.hash()) {
+        return ValidationResult::kUnknownParent;
+    }
+
+    return validate_against_parent(header, parent, config, ethash_epochs);
+}
+
+std::pair<size_t, ValidationResult> validate_header_range(gsl::span<const BlockHeader> headers, unsigned num_threads,
+                                                          const ChainConfig& config,
+                                                          EthashEpochManager* ethash_epochs) {
+    const size_t n{static_cast<size_t>(headers.size())};
+    if (n < 2) {
+        return {n, ValidationResult::kOk};
+    }
+
+    // Headers past the first invalid one found so far are skipped
+    std::atomic<size_t> first_invalid{n};
+    std::vector<ValidationResult> results(n, ValidationResult::kOk);
+    parallel_for_each(n - 1, num_threads, [&](size_t i) {
+        const size_t index{i + 1};
+        if (index > first_invalid.load(std::memory_order_relaxed)) {
+            return;
+        }
+        results[index] = validate_block_header(headers[index], headers[index - 1], config, ethash_epochs);
+        if (results[index] != ValidationResult::kOk) {
+            size_t current{first_invalid.load()};
+            while (index < current && !first_invalid.compare_exchange_weak(current, index)) {
+            }
+        }
+    });
+
+    const size_t index{first_invalid.load()};
+    return {index, index < n ? results[index] : ValidationResult::kOk};
+}
+
 // See [YP] Section 11.1 "Ommer Validation"
 static bool is_kin(const BlockHeader& branch_header, const BlockHeader& mainline_header,
                    const evmc::bytes32& mainline_hash, unsigned n, const StateBuffer& state,
@@ -105,10 +173,12 @@ static bool is_kin(const BlockHeader& branch_header, const BlockHeader& mainline
     return is_kin(branch_header, *mainline_parent, mainline_header.parent_hash, n - 1, state, old_ommers);
 }
 
-ValidationResult pre_validate_block(const Block& block, const StateBuffer& state, const ChainConfig& config) {
+ValidationResult pre_validate_block(const Block& block, const StateBuffer& state, const ChainConfig& config,
+                                    EthashEpochManager* ethash_epochs) {
     const BlockHeader& header{block.header};
 
-    if (ValidationResult err{validate_block_header(header, state, config)}; err != ValidationResult::kOk) {
+    if (ValidationResult err{validate_block_header(header, state, config, ethash_epochs)};
+        err != ValidationResult::kOk) {
         return err;
     }
 
@@ -135,7 +205,8 @@ ValidationResult pre_validate_block(const Block& block, const StateBuffer& state
     std::optional<BlockHeader> parent{get_parent(state, header)};
 
     for (const BlockHeader& ommer : block.ommers) {
-        if (ValidationResult err{validate_block_header(ommer, state, config)}; err != ValidationResult::kOk) {
+        if (ValidationResult err{validate_block_header(ommer, state, config, ethash_epochs)};
+            err != ValidationResult::kOk) {
             return ValidationResult::kInvalidOmmerHeader;
         }
         std::vector<BlockHeader> old_ommers;
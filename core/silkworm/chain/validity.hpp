@@ -17,11 +17,15 @@
 #ifndef SILKWORM_CHAIN_VALIDITY_HPP_
 #define SILKWORM_CHAIN_VALIDITY_HPP_
 
+#include <gsl/span>
 #include <silkworm/state/buffer.hpp>
 #include <silkworm/types/block.hpp>
+#include <utility>
 
 namespace silkworm {
 
+class EthashEpochManager;  // see ethash_epochs.hpp, only available with SILKWORM_CORE_THREADS
+
 // Classification of invalid transactions and blocks.
 enum class [[nodiscard]] ValidationResult{
     kOk = 0,
@@ -52,19 +56,41 @@ enum class [[nodiscard]] ValidationResult{
 
     // See [YP] Section 11.2 "Transaction Validation", Eq (160)
     kWrongBlockGas,  // BHg ≠ l(BR)u
+
+    // See [YP] Section 4.3.4 "Block Header Validity", Eq (50)
+    kInvalidSeal,  // n > 2^256/Hd ∨ m ≠ Hm, where (n, m) = PoW(H, Hn, d)
 };
 
 // Performs validation of block header & body that can be done prior to execution.
 // See [YP] Sections 4.3.2 "Holistic Validity", 4.3.4 "Block Header Validity",
 // and 11.1 "Ommer Validation".
+// The Ethash proof of work is only verified if ethash_epochs isn't null.
 // Shouldn't be used for genesis block.
 ValidationResult pre_validate_block(const Block& block, const StateBuffer& state,
-                                    const ChainConfig& config = kMainnetConfig);
+                                    const ChainConfig& config = kMainnetConfig,
+                                    EthashEpochManager* ethash_epochs = nullptr);
 
 // See [YP] Section 4.3.4 "Block Header Validity".
+// The Ethash proof of work is only verified if ethash_epochs isn't null.
 // Shouldn't be used for genesis block.
 ValidationResult validate_block_header(const BlockHeader& header, const StateBuffer& state,
-                                       const ChainConfig& config = kMainnetConfig);
+                                       const ChainConfig& config = kMainnetConfig,
+                                       EthashEpochManager* ethash_epochs = nullptr);
+
+// Same as above, but against the given parent rather than the one in the state.
+ValidationResult validate_block_header(const BlockHeader& header, const BlockHeader& parent,
+                                       const ChainConfig& config = kMainnetConfig,
+                                       EthashEpochManager* ethash_epochs = nullptr);
+
+// Validates every header from headers[1] on against its predecessor, spreading the work
+// over up to num_threads threads (the calling one included), e.g. to check stored blocks again.
+// headers[0] itself isn't validated.
+// Returns the index of the first invalid header and why it is invalid,
+// or headers.size() and kOk if all of them are valid.
+std::pair<size_t, ValidationResult> validate_header_range(gsl::span<const BlockHeader> headers,
+                                                          unsigned num_threads,
+                                                          const ChainConfig& config = kMainnetConfig,
+                                                          EthashEpochManager* ethash_epochs = nullptr);
 
 }  // namespace silkworm
 
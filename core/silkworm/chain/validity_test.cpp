@@ -0,0 +1,76 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "validity.hpp"
+
+#include <catch2/catch.hpp>
+#include <vector>
+
+#include "difficulty.hpp"
+
+namespace silkworm {
+
+// Valid headers of Frontier, each the parent of the next one
+static std::vector<BlockHeader> make_header_chain(size_t n) {
+    std::vector<BlockHeader> headers(n);
+    headers[0].number = 100'000;
+    headers[0].difficulty = 3'000'000'000'000;
+    headers[0].gas_limit = 3'141'592;
+    headers[0].timestamp = 1'440'000'000;
+    headers[0].ommers_hash = kEmptyListHash;
+    for (size_t i{1}; i < n; ++i) {
+        const BlockHeader& parent{headers[i - 1]};
+        BlockHeader& header{headers[i]};
+        header.parent_hash = parent.hash();
+        header.ommers_hash = kEmptyListHash;
+        header.number = parent.number + 1;
+        header.gas_limit = parent.gas_limit + (i % 3 == 0 ? 1'000 : 0);
+        header.gas_used = header.gas_limit / 2;
+        header.timestamp = parent.timestamp + 5 + i % 20;
+        header.difficulty = canonical_difficulty(header.number, header.timestamp, parent.difficulty,
+                                                 parent.timestamp, /*parent_has_uncles=*/false, kMainnetConfig);
+    }
+    return headers;
+}
+
+TEST_CASE("Validate header range") {
+    const std::vector<BlockHeader> headers{make_header_chain(500)};
+
+    for (unsigned num_threads : {1u, 4u}) {
+        CHECK(validate_header_range(headers, num_threads) == std::pair{headers.size(), ValidationResult::kOk});
+
+        std::vector<BlockHeader> invalid{headers};
+        invalid[320].gas_used = invalid[320].gas_limit + 1;
+        CHECK(validate_header_range(invalid, num_threads) == std::pair{size_t{320}, ValidationResult::kGasAboveLimit});
+
+        // The first invalid header is reported
+        invalid[150].difficulty += 1;
+        CHECK(validate_header_range(invalid, num_threads) ==
+              std::pair{size_t{150}, ValidationResult::kWrongDifficulty});
+
+        // Changing a header makes the following one point at another parent
+        invalid[150] = headers[150];
+        invalid[42].beneficiary = 0x829bd824b016326a401d083b33d092293333a830_address;
+        CHECK(validate_header_range(invalid, num_threads) == std::pair{size_t{43}, ValidationResult::kUnknownParent});
+    }
+
+    // Nothing to validate without a parent
+    CHECK(validate_header_range(gsl::span<const BlockHeader>{headers.data(), 1}, 4) ==
+          std::pair{size_t{1}, ValidationResult::kOk});
+}
+
+}  // namespace silkworm
@@ -0,0 +1,213 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_COMMON_FLAT_HASH_MAP_H_
+#define SILKWORM_COMMON_FLAT_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace silkworm {
+
+// Hash of a key made of plain bytes without padding (addresses, hashes, integers...).
+// The 64 bits are mixed so that FlatHashMap can take the top ones, also on 32-bit platforms.
+template <class Key>
+struct FlatHash {
+    static_assert(std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>);
+
+    uint64_t operator()(const Key& key) const noexcept {
+        const auto* p{reinterpret_cast<const uint8_t*>(&key)};
+        uint64_t h{sizeof(Key)};
+        for (size_t i{0}; i < sizeof(Key); i += 8) {
+            uint64_t word{0};
+            std::memcpy(&word, p + i, std::min<size_t>(8, sizeof(Key) - i));
+            h = (h ^ word) * 0x9e3779b97f4a7c15;  // 2^64 / golden ratio
+            h ^= h >> 29;
+        }
+        return h * 0x9e3779b97f4a7c15;
+    }
+};
+
+// Hash map with open addressing & linear probing over a single array of entries,
+// so lookups touch one or two cache lines instead of chasing bucket lists.
+// Erasure shifts the following entries back rather than leaving tombstones.
+// Unlike std::unordered_map, any insertion or erasure invalidates references & iterators.
+template <class Key, class T, class Hash = FlatHash<Key>>
+class FlatHashMap {
+  public:
+    using value_type = std::pair<Key, T>;
+
+    template <bool kConst>
+    class Iterator {
+      public:
+        using Map = std::conditional_t<kConst, const FlatHashMap, FlatHashMap>;
+        using reference = std::conditional_t<kConst, const value_type&, value_type&>;
+        using pointer = std::conditional_t<kConst, const value_type*, value_type*>;
+
+        Iterator(Map* map, size_t index) : map_{map}, index_{index} { skip_empty(); }
+
+        reference operator*() const { return map_->entries_[index_]; }
+        pointer operator->() const { return &map_->entries_[index_]; }
+
+        Iterator& operator++() {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+      private:
+        friend class FlatHashMap;
+
+        void skip_empty() {
+            while (index_ < map_->used_.size() && !map_->used_[index_]) {
+                ++index_;
+            }
+        }
+
+        Map* map_;
+        size_t index_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, used_.size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, used_.size()}; }
+
+    iterator find(const Key& key) { return {this, lookup(key)}; }
+    const_iterator find(const Key& key) const { return {this, lookup(key)}; }
+
+    bool contains(const Key& key) const { return lookup(key) != used_.size(); }
+
+    // Inserts a value-initialized T unless the key is already present.
+    std::pair<iterator, bool> try_emplace(const Key& key) {
+        if ((size_ + 1) * 4 > used_.size() * 3) {
+            grow();
+        }
+        size_t i{home(key)};
+        for (; used_[i]; i = next(i)) {
+            if (entries_[i].first == key) {
+                return {{this, i}, false};
+            }
+        }
+        used_[i] = true;
+        entries_[i].first = key;
+        ++size_;
+        return {{this, i}, true};
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    size_t erase(const Key& key) {
+        size_t i{lookup(key)};
+        if (i == used_.size()) {
+            return 0;
+        }
+
+        // Backward shift deletion: move back every following entry of the run that may take the hole
+        for (size_t j{next(i)}; used_[j]; j = next(j)) {
+            const size_t h{home(entries_[j].first)};
+            // Entry j can fill the hole unless its home lies cyclically in (i, j]
+            const bool stays{i <= j ? (i < h && h <= j) : (i < h || h <= j)};
+            if (!stays) {
+                entries_[i] = std::move(entries_[j]);
+                i = j;
+            }
+        }
+        used_[i] = false;
+        entries_[i] = value_type{};
+        --size_;
+        return 1;
+    }
+
+    void clear() {
+        entries_.clear();
+        used_.clear();
+        size_ = 0;
+        shift_ = 64;
+    }
+
+    void reserve(size_t n) {
+        while (n * 4 > used_.size() * 3) {
+            grow();
+        }
+    }
+
+  private:
+    size_t home(const Key& key) const { return static_cast<size_t>(Hash{}(key) >> shift_); }
+
+    size_t next(size_t i) const { return (i + 1) & (used_.size() - 1); }
+
+    // Index of the key or used_.size() if absent
+    size_t lookup(const Key& key) const {
+        if (size_ == 0) {
+            return used_.size();
+        }
+        for (size_t i{home(key)}; used_[i]; i = next(i)) {
+            if (entries_[i].first == key) {
+                return i;
+            }
+        }
+        return used_.size();
+    }
+
+    void grow() {
+        std::vector<value_type> entries(std::max<size_t>(16, entries_.size() * 2));
+        std::vector<uint8_t> used(entries.size());
+        shift_ = 64;
+        for (size_t n{entries.size()}; n > 1; n >>= 1) {
+            --shift_;
+        }
+
+        entries_.swap(entries);
+        used_.swap(used);
+        for (size_t j{0}; j < used.size(); ++j) {
+            if (used[j]) {
+                size_t i{home(entries[j].first)};
+                while (used_[i]) {
+                    i = next(i);
+                }
+                used_[i] = true;
+                entries_[i] = std::move(entries[j]);
+            }
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<uint8_t> used_;
+    size_t size_{0};
+    unsigned shift_{64};  // 64 - log2(capacity)
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_COMMON_FLAT_HASH_MAP_H_
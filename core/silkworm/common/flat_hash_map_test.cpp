@@ -0,0 +1,83 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "flat_hash_map.hpp"
+
+#include <catch2/catch.hpp>
+#include <map>
+#include <random>
+#include <silkworm/common/base.hpp>
+
+namespace silkworm {
+
+TEST_CASE("FlatHashMap") {
+    FlatHashMap<evmc::address, uint64_t> map;
+    CHECK(map.empty());
+    CHECK(map.find(0x0a_address) == map.end());
+    CHECK(map.erase(0x0a_address) == 0);
+
+    map[0x0a_address] = 1;
+    map[0x0b_address] = 2;
+    CHECK(map.size() == 2);
+    CHECK(map.find(0x0a_address)->second == 1);
+    CHECK(!map.try_emplace(0x0b_address).second);
+    CHECK(map[0x0b_address] == 2);
+    CHECK(map[0x0c_address] == 0);
+    CHECK(map.size() == 3);
+
+    CHECK(map.erase(0x0a_address) == 1);
+    CHECK(!map.contains(0x0a_address));
+    CHECK(map.contains(0x0b_address));
+    CHECK(map.size() == 2);
+}
+
+TEST_CASE("FlatHashMap against std::map") {
+    // Few distinct keys so that runs of colliding entries get erased from & reinserted into
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<uint64_t> key_dist{0, 2'000};
+
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::map<uint64_t, uint64_t> expected;
+    for (uint64_t i{0}; i < 100'000; ++i) {
+        const uint64_t key{key_dist(rng)};
+        if (rng() % 3 == 0) {
+            REQUIRE(map.erase(key) == expected.erase(key));
+        } else {
+            map[key] = i;
+            expected[key] = i;
+        }
+        REQUIRE(map.size() == expected.size());
+    }
+
+    for (uint64_t key{0}; key <= 2'000; ++key) {
+        auto it{map.find(key)};
+        auto expected_it{expected.find(key)};
+        if (expected_it == expected.end()) {
+            CHECK(it == map.end());
+        } else {
+            REQUIRE(it != map.end());
+            CHECK(it->second == expected_it->second);
+        }
+    }
+
+    std::map<uint64_t, uint64_t> iterated;
+    for (const auto& [key, value] : map) {
+        iterated[key] = value;
+    }
+    CHECK(iterated == expected);
+}
+
+}  // namespace silkworm
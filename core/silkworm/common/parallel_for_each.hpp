@@ -0,0 +1,109 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_COMMON_PARALLEL_FOR_EACH_H_
+#define SILKWORM_COMMON_PARALLEL_FOR_EACH_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef SILKWORM_CORE_THREADS
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#endif
+
+namespace silkworm {
+
+// Number of threads the hardware runs concurrently, 1 if unknown or if built without SILKWORM_CORE_THREADS.
+inline unsigned hardware_threads() noexcept {
+#ifdef SILKWORM_CORE_THREADS
+    const unsigned n{std::thread::hardware_concurrency()};
+    return n ? n : 1;
+#else
+    return 1;
+#endif
+}
+
+// Invokes func(i) for every i in [0, n) spreading the calls over up to num_threads threads
+// (the calling one included).
+// If func throws, no more calls are started and the exception is rethrown once the threads are done.
+// Without SILKWORM_CORE_THREADS (e.g. in WebAssembly) all the calls are made by the calling thread.
+template <class Func>
+void parallel_for_each(size_t n, unsigned num_threads, const Func& func) {
+#ifdef SILKWORM_CORE_THREADS
+    num_threads = static_cast<unsigned>(std::min<size_t>(num_threads, n));
+#else
+    num_threads = 1;
+#endif
+    if (num_threads <= 1) {
+        for (size_t i{0}; i < n; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+#ifdef SILKWORM_CORE_THREADS
+
+    // Items are handed out in chunks to limit contention on the counter
+    const size_t chunk{std::max<size_t>(1, n / (num_threads * 64))};
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t begin{next.fetch_add(chunk)}; begin < n; begin = next.fetch_add(chunk)) {
+            for (size_t i{begin}, end{std::min(n, begin + chunk)}; i < end; ++i) {
+                func(i);
+            }
+        }
+    };
+
+#ifdef __cpp_exceptions
+    // An exception escaping a thread would terminate the program
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto run = [&](unsigned t) {
+        try {
+            work();
+        } catch (...) {
+            errors[t] = std::current_exception();
+            next = n;
+        }
+    };
+#else
+    auto run = [&](unsigned) { work(); };
+#endif
+
+    std::vector<std::thread> threads;
+    for (unsigned t{1}; t < num_threads; ++t) {
+        threads.emplace_back(run, t);
+    }
+    run(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+#ifdef __cpp_exceptions
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#endif
+#endif
+}
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_COMMON_PARALLEL_FOR_EACH_H_
@@ -0,0 +1,36 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_for_each.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("Parallel for each") {
+    std::vector<size_t> out(100'000);
+    parallel_for_each(out.size(), 4, [&out](size_t i) { out[i] = i * i; });
+    for (size_t i{0}; i < out.size(); ++i) {
+        REQUIRE(out[i] == i * i);
+    }
+
+    // More threads than items
+    std::vector<size_t> few(3);
+    parallel_for_each(few.size(), 8, [&few](size_t i) { few[i] = i + 1; });
+    CHECK(few == std::vector<size_t>{1, 2, 3});
+}
+
+}  // namespace silkworm
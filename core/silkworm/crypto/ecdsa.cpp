@@ -54,27 +54,40 @@ bool is_valid_signature(const intx::uint256& r, const intx::uint256& s, bool hom
     return true;
 }
 
+// Recovery only takes the tables for multiplication by arbitrary points, not those for signing
+static const secp256k1_context* recovery_context() noexcept {
+    static const secp256k1_context* context{secp256k1_context_create(SECP256K1_CONTEXT_VERIFY)};
+    return context;
+}
+
 std::optional<Bytes> recover(ByteView message, ByteView signature, uint8_t recovery_id) {
-    static secp256k1_context* context{secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY)};
+    PublicKey key;
+    if (!recover(key, message, signature, recovery_id)) {
+        return std::nullopt;
+    }
+    return Bytes{key.data(), key.size()};
+}
+
+bool recover(PublicKey& out, ByteView message, ByteView signature, uint8_t recovery_id) noexcept {
+    const secp256k1_context* context{recovery_context()};
 
     if (message.length() != 32 || signature.length() != 64) {
-        return std::nullopt;
+        return false;
     }
 
     secp256k1_ecdsa_recoverable_signature sig;
     if (!secp256k1_ecdsa_recoverable_signature_parse_compact(context, &sig, &signature[0], recovery_id)) {
-        return std::nullopt;
+        return false;
     }
 
     secp256k1_pubkey pub_key;
     if (!secp256k1_ecdsa_recover(context, &pub_key, &sig, &message[0])) {
-        return std::nullopt;
+        return false;
     }
 
-    size_t kOutLen{65};
-    Bytes out(kOutLen, '\0');
-    secp256k1_ec_pubkey_serialize(context, &out[0], &kOutLen, &pub_key, SECP256K1_EC_UNCOMPRESSED);
-    return out;
+    size_t out_len{out.size()};
+    secp256k1_ec_pubkey_serialize(context, out.data(), &out_len, &pub_key, SECP256K1_EC_UNCOMPRESSED);
+    return true;
 }
 
 }  // namespace silkworm::ecdsa
@@ -19,6 +19,7 @@
 
 // See Yellow Paper, Appendix F "Signing Transactions"
 
+#include <array>
 #include <intx/intx.hpp>
 #include <optional>
 #include <silkworm/common/base.hpp>
@@ -47,6 +48,13 @@ bool is_valid_signature(const intx::uint256& r, const intx::uint256& s, bool hom
 // Tries recover the public key used for message signing
 std::optional<Bytes> recover(ByteView message, ByteView signature, uint8_t recovery_id);
 
+// Uncompressed public key: 0x04 followed by X & Y
+using PublicKey = std::array<uint8_t, 65>;
+
+// Same as above, except that the public key is written into out instead of allocated.
+// Returns false, leaving out unspecified, if recovery fails.
+bool recover(PublicKey& out, ByteView message, ByteView signature, uint8_t recovery_id) noexcept;
+
 }  // namespace silkworm::ecdsa
 
 #endif  // SILKWORM_CRYPTO_ECDSA_H_
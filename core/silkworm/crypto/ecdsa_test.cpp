@@ -0,0 +1,49 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "ecdsa.hpp"
+
+#include <catch2/catch.hpp>
+#include <ethash/keccak.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm::ecdsa {
+
+TEST_CASE("Public key recovery in place") {
+    const Bytes message{*from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c")};
+    const Bytes signature{
+        *from_hex("73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75feeb940b1d03b21e36b0e47e79769f095"
+                  "fe2ab855bd91e3a38756b7d75a9c4549")};
+    const Bytes zeros(64, '\0');
+
+    PublicKey key;
+    CHECK(!recover(key, message, ByteView{signature}.substr(1), 1));  // too short
+    CHECK(!recover(key, message, zeros, 1));                          // r & s out of range
+
+    for (uint8_t recovery_id : {0, 1}) {
+        const std::optional<Bytes> allocated{recover(message, signature, recovery_id)};
+        REQUIRE(allocated);
+        REQUIRE(recover(key, message, signature, recovery_id));
+        CHECK(key[0] == 4);
+        CHECK(ByteView{key.data(), key.size()} == *allocated);
+    }
+
+    REQUIRE(recover(key, message, signature, 1));
+    const ethash::hash256 hash{ethash::keccak256(&key[1], key.size() - 1)};
+    CHECK(to_hex(full_view(hash.bytes).substr(12)) == "a94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+}
+
+}  // namespace silkworm::ecdsa
@@ -0,0 +1,202 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "keccak_batch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ethash/keccak.hpp>
+
+// Multi-lane kernels rely on GCC/Clang vector extensions & function multiversioning;
+// state words are loaded as is, which assumes a little-endian CPU.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SILKWORM_KECCAK_MULTI_LANE 1
+#endif
+
+namespace silkworm::crypto {
+
+#if SILKWORM_KECCAK_MULTI_LANE
+
+// Rate of Keccak-256 in bytes and in 64-bit words
+static constexpr size_t kRate{136};
+static constexpr size_t kRateWords{kRate / 8};
+
+static constexpr uint64_t kRoundConstants[24]{
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+    0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+// Rho rotations & Pi destinations, following the lane (1, 0) around its orbit
+static constexpr unsigned kRho[24]{1,  3,  6,  10, 15, 21, 28, 36, 45, 55, 2,  14,
+                                   27, 41, 56, 8,  25, 43, 62, 18, 39, 61, 20, 44};
+static constexpr unsigned kPi[24]{10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+using Lanes4 = uint64_t __attribute__((vector_size(32)));
+using Lanes8 = uint64_t __attribute__((vector_size(64)));
+
+// Keccak-f[1600] applied to as many states as V has 64-bit elements.
+// Inner loops are unrolled so that rotations & lane indices become constants.
+// Rotations are spelled out rather than factored into a helper taking vectors by value,
+// which would have its ABI depend on the target.
+template <class V>
+[[gnu::always_inline]] inline void keccakf1600(V* a) noexcept {
+    V c[5];
+    for (uint64_t rc : kRoundConstants) {
+        // Theta
+#pragma GCC unroll 25
+        for (size_t x{0}; x < 5; ++x) {
+            c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        }
+#pragma GCC unroll 25
+        for (size_t x{0}; x < 5; ++x) {
+            const V d{c[(x + 4) % 5] ^ ((c[(x + 1) % 5] << 1) | (c[(x + 1) % 5] >> 63))};
+#pragma GCC unroll 25
+            for (size_t y{0}; y < 25; y += 5) {
+                a[y + x] ^= d;
+            }
+        }
+
+        // Rho & Pi
+        V t{a[1]};
+#pragma GCC unroll 25
+        for (size_t i{0}; i < 24; ++i) {
+            const V next{a[kPi[i]]};
+            a[kPi[i]] = (t << kRho[i]) | (t >> (64 - kRho[i]));
+            t = next;
+        }
+
+        // Chi
+#pragma GCC unroll 25
+        for (size_t y{0}; y < 25; y += 5) {
+#pragma GCC unroll 25
+            for (size_t x{0}; x < 5; ++x) {
+                c[x] = a[y + x];
+            }
+#pragma GCC unroll 25
+            for (size_t x{0}; x < 5; ++x) {
+                a[y + x] = c[x] ^ (~c[(x + 1) % 5] & c[(x + 2) % 5]);
+            }
+        }
+
+        // Iota
+        a[0] ^= rc;
+    }
+}
+
+// Hashes up to kLanes inputs, one per element of V.
+// Each input is absorbed up to its padded last block, after which its lane just idles
+// until the longest input of the group is done.
+template <class V, size_t kLanes>
+[[gnu::always_inline]] inline void keccak256_lanes(ethash::hash256* out, const ByteView* in, size_t n) noexcept {
+    size_t num_blocks[kLanes]{};
+    size_t max_blocks{0};
+    for (size_t lane{0}; lane < n; ++lane) {
+        num_blocks[lane] = in[lane].length() / kRate + 1;
+        max_blocks = std::max(max_blocks, num_blocks[lane]);
+    }
+
+    V state[25]{};
+    uint8_t last_block[kRate];
+    for (size_t block{0}; block < max_blocks; ++block) {
+        for (size_t lane{0}; lane < n; ++lane) {
+            if (block >= num_blocks[lane]) {
+                continue;
+            }
+            const uint8_t* data{in[lane].data() + block * kRate};
+            if (block + 1 == num_blocks[lane]) {
+                const size_t remaining{in[lane].length() - block * kRate};
+                if (remaining) {
+                    std::memcpy(last_block, data, remaining);
+                }
+                std::memset(last_block + remaining, 0, kRate - remaining);
+                last_block[remaining] ^= 0x01;
+                last_block[kRate - 1] ^= 0x80;
+                data = last_block;
+            }
+            for (size_t i{0}; i < kRateWords; ++i) {
+                uint64_t word;
+                std::memcpy(&word, data + i * 8, 8);
+                state[i][lane] ^= word;
+            }
+        }
+
+        keccakf1600(state);
+
+        for (size_t lane{0}; lane < n; ++lane) {
+            if (block + 1 == num_blocks[lane]) {
+                for (size_t i{0}; i < 4; ++i) {
+                    out[lane].word64s[i] = state[i][lane];
+                }
+            }
+        }
+    }
+}
+
+[[gnu::target("avx2")]] static void keccak256_x4(ethash::hash256* out, const ByteView* in, size_t n) noexcept {
+    keccak256_lanes<Lanes4, 4>(out, in, n);
+}
+
+[[gnu::target("avx512f")]] static void keccak256_x8(ethash::hash256* out, const ByteView* in, size_t n) noexcept {
+    keccak256_lanes<Lanes8, 8>(out, in, n);
+}
+
+#endif  // SILKWORM_KECCAK_MULTI_LANE
+
+using Kernel = void (*)(ethash::hash256* out, const ByteView* in, size_t n) noexcept;
+
+struct KernelSelection {
+    Kernel kernel{nullptr};  // nullptr stands for one input at a time
+    size_t lanes{1};
+};
+
+static KernelSelection select_kernel() noexcept {
+#if SILKWORM_KECCAK_MULTI_LANE
+    if (__builtin_cpu_supports("avx512f")) {
+        return {keccak256_x8, 8};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {keccak256_x4, 4};
+    }
+#endif
+    return {};
+}
+
+static const KernelSelection& kernel_selection() noexcept {
+    static const KernelSelection selection{select_kernel()};
+    return selection;
+}
+
+size_t keccak256_batch_lanes() noexcept { return kernel_selection().lanes; }
+
+void keccak256_batch(gsl::span<ethash::hash256> out, gsl::span<const ByteView> in) noexcept {
+    const auto& [kernel, lanes]{kernel_selection()};
+    const size_t count{static_cast<size_t>(in.size())};
+    size_t i{0};
+    if (kernel) {
+        // A lone trailing input is cheaper to hash by itself than in an otherwise idle group
+        for (; count - i >= 2; i += std::min(lanes, count - i)) {
+            kernel(&out[i], &in[i], std::min(lanes, count - i));
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = ethash::keccak256(in[i].data(), in[i].length());
+    }
+}
+
+}  // namespace silkworm::crypto
@@ -0,0 +1,41 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_CRYPTO_KECCAK_BATCH_HPP_
+#define SILKWORM_CRYPTO_KECCAK_BATCH_HPP_
+
+#include <ethash/hash_types.hpp>
+#include <gsl/span>
+#include <silkworm/common/base.hpp>
+
+namespace silkworm::crypto {
+
+// Number of inputs that keccak256_batch hashes simultaneously on this CPU:
+// 8 with AVX-512, 4 with AVX2, 1 otherwise (plain ethash::keccak256).
+size_t keccak256_batch_lanes() noexcept;
+
+/** @brief Calculates Keccak-256 of every input: out[i] = keccak256(in[i]).
+ *
+ * Inputs are spread over the SIMD lanes of the CPU and go through Keccak-f[1600] together,
+ * a group taking as many permutations as its longest input needs.
+ * Hence batching pays off when inputs span the same number of 136-byte blocks, e.g. keys & addresses.
+ * @param out must be at least as long as in.
+ */
+void keccak256_batch(gsl::span<ethash::hash256> out, gsl::span<const ByteView> in) noexcept;
+
+}  // namespace silkworm::crypto
+
+#endif  // SILKWORM_CRYPTO_KECCAK_BATCH_HPP_
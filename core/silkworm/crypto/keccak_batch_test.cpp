@@ -0,0 +1,76 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "keccak_batch.hpp"
+
+#include <catch2/catch.hpp>
+#include <ethash/keccak.hpp>
+#include <silkworm/common/util.hpp>
+#include <vector>
+
+namespace silkworm::crypto {
+
+static void check_batch(const std::vector<Bytes>& inputs) {
+    std::vector<ByteView> views(inputs.begin(), inputs.end());
+    std::vector<ethash::hash256> hashes(inputs.size());
+    keccak256_batch(hashes, views);
+    for (size_t i{0}; i < inputs.size(); ++i) {
+        CHECK(to_hex(full_view(hashes[i].bytes)) == to_hex(full_view(keccak256(inputs[i]).bytes)));
+    }
+}
+
+TEST_CASE("Batched Keccak-256") {
+    const size_t lanes{keccak256_batch_lanes()};
+    CHECK((lanes == 1 || lanes == 4 || lanes == 8));
+
+    SECTION("Known value") {
+        std::vector<ByteView> in{ByteView{}};
+        std::vector<ethash::hash256> out(1);
+        keccak256_batch(out, in);
+        CHECK(to_hex(full_view(out[0].bytes)) == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    }
+
+    SECTION("Equal lengths") {
+        // Around the 136-byte rate, including the padding bytes landing on the same byte
+        for (size_t length : {0, 1, 20, 32, 64, 134, 135, 136, 137, 271, 272, 273}) {
+            std::vector<Bytes> inputs;
+            for (size_t i{0}; i < 2 * lanes + 3; ++i) {
+                inputs.emplace_back(length, static_cast<uint8_t>(i * 31 + length));
+            }
+            check_batch(inputs);
+        }
+    }
+
+    SECTION("Mixed lengths") {
+        std::vector<Bytes> inputs;
+        for (size_t length{0}; length < 420; length += 7) {
+            Bytes input(length, '\0');
+            for (size_t i{0}; i < length; ++i) {
+                input[i] = static_cast<uint8_t>(i ^ length);
+            }
+            inputs.push_back(input);
+        }
+        check_batch(inputs);
+    }
+
+    SECTION("Any batch size") {
+        for (size_t count{0}; count <= 2 * lanes + 1; ++count) {
+            check_batch(std::vector<Bytes>(count, Bytes(32, 0xab)));
+        }
+    }
+}
+
+}  // namespace silkworm::crypto
@@ -176,7 +176,7 @@ evmc::result EVM::call(const evmc_message& message) noexcept {
         if (gas < 0 || gas > message.gas) {
             res.status_code = EVMC_OUT_OF_GAS;
         } else {
-            std::optional<Bytes> output{contract.run(input)};
+            std::optional<Bytes> output{precompile_cache ? precompile_cache->run(num - 1, input) : contract.run(input)};
             if (output) {
                 res = {EVMC_SUCCESS, message.gas - gas, output->data(), output->size()};
             } else {
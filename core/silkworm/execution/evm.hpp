@@ -23,6 +23,7 @@
 #include <intx/intx.hpp>
 #include <silkworm/chain/config.hpp>
 #include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
 #include <silkworm/execution/state_pool.hpp>
 #include <silkworm/state/intra_block_state.hpp>
 #include <silkworm/types/block.hpp>
@@ -61,6 +62,8 @@ class EVM {
 
     ExecutionStatePool* state_pool{nullptr};  // use for better performance
 
+    PrecompileCache* precompile_cache{nullptr};  // use when inputs repeat, e.g. blocks executed again
+
   private:
     friend class EvmHost;
 
@@ -20,6 +20,7 @@
 #include <silkworm/chain/config.hpp>
 #include <silkworm/chain/validity.hpp>
 #include <silkworm/execution/analysis_cache.hpp>
+#include <silkworm/execution/precompile_cache.hpp>
 #include <silkworm/execution/state_pool.hpp>
 #include <silkworm/state/buffer.hpp>
 #include <silkworm/types/block.hpp>
@@ -36,11 +37,13 @@ namespace silkworm {
  * Warning: This method does not verify state root;
  * pre-Byzantium receipt root isn't validated either.
  *
- * For better performance use AnalysisCache & ExecutionStatePool.
+ * For better performance use AnalysisCache & ExecutionStatePool,
+ * as well as PrecompileCache when blocks are executed again.
  */
 [[nodiscard]] std::pair<std::vector<Receipt>, ValidationResult> execute_block(
     const Block& block, StateBuffer& buffer, const ChainConfig& config = kMainnetConfig,
-    AnalysisCache* analysis_cache = nullptr, ExecutionStatePool* state_pool = nullptr) noexcept;
+    AnalysisCache* analysis_cache = nullptr, ExecutionStatePool* state_pool = nullptr,
+    PrecompileCache* precompile_cache = nullptr) noexcept;
 
 }  // namespace silkworm
 
@@ -0,0 +1,60 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "precompile_cache.hpp"
+
+#include <ostream>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+bool PrecompileCache::is_cached(size_t contract) noexcept {
+    // SHA256, RIPEMD160 and the identity cost about as much as Keccak of their input
+    return contract != 1 && contract != 2 && contract != 3;
+}
+
+std::optional<Bytes> PrecompileCache::run(size_t contract, ByteView input) noexcept {
+    const precompiled::Contract& c{precompiled::kContracts[contract]};
+    if (!is_cached(contract)) {
+        return c.run(input);
+    }
+
+    const PrecompileInput key{contract, to_bytes32(full_view(keccak256(input).bytes))};
+
+    Stats& stats{stats_[contract]};
+    if (const std::optional<Bytes>* output{cache_.get(key)}; output) {
+        ++stats.hits;
+        return *output;
+    }
+    ++stats.misses;
+
+    std::optional<Bytes> output{c.run(input)};
+    cache_.put(key, output);
+    return output;
+}
+
+void PrecompileCache::report(std::ostream& out) const {
+    for (size_t i{0}; i < precompiled::kNumOfIstanbulContracts; ++i) {
+        const Stats& stats{stats_[i]};
+        const uint64_t lookups{stats.hits + stats.misses};
+        if (lookups > 0) {
+            out << "Precompile 0x" << std::hex << i + 1 << std::dec << ": " << stats.hits << " hits of " << lookups
+                << " lookups (" << 100.0 * stats.hits / lookups << "%)\n";
+        }
+    }
+}
+
+}  // namespace silkworm
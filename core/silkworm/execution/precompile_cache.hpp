@@ -0,0 +1,95 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_EXECUTION_PRECOMPILE_CACHE_H_
+#define SILKWORM_EXECUTION_PRECOMPILE_CACHE_H_
+
+#include <array>
+#include <evmc/evmc.hpp>
+#include <iosfwd>
+#include <lrucache.hpp>
+#include <optional>
+#include <silkworm/common/base.hpp>
+#include <silkworm/execution/precompiled.hpp>
+
+namespace silkworm {
+
+// Identifies a run of a precompile: precompiled::kContracts[contract] on the input hashing to input_hash
+struct PrecompileInput {
+    size_t contract{0};
+    evmc::bytes32 input_hash;
+};
+
+inline bool operator==(const PrecompileInput& a, const PrecompileInput& b) noexcept {
+    return a.contract == b.contract && a.input_hash == b.input_hash;
+}
+
+}  // namespace silkworm
+
+namespace std {
+
+template <>
+struct hash<silkworm::PrecompileInput> {
+    size_t operator()(const silkworm::PrecompileInput& x) const noexcept {
+        return hash<evmc::bytes32>{}(x.input_hash) ^ x.contract;
+    }
+};
+
+}  // namespace std
+
+namespace silkworm {
+
+/** @brief Cache of precompiled contract outputs by input.
+ *
+ * Saves running a precompile again on an input it has already seen, e.g. the same signature
+ * checked by a multisig wallet or the same proof checked by a bridge, within a block or across blocks.
+ * Outputs don't depend on the EVM revision, so entries stay valid when blocks are executed again.
+ * Only precompiles that take longer to run than it takes to hash their input are cached.
+ */
+class PrecompileCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{10'000};
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit PrecompileCache(size_t maxSize = kDefaultMaxSize) : cache_{maxSize} {}
+
+    PrecompileCache(const PrecompileCache&) = delete;
+    PrecompileCache& operator=(const PrecompileCache&) = delete;
+
+    // Whether outputs of precompiled::kContracts[contract] are cached
+    static bool is_cached(size_t contract) noexcept;
+
+    // Output of precompiled::kContracts[contract].run, reused if the input has been run before
+    std::optional<Bytes> run(size_t contract, ByteView input) noexcept;
+
+    // Lookups of precompiled::kContracts[contract], for cached contracts only
+    const Stats& stats(size_t contract) const noexcept { return stats_[contract]; }
+
+    // Prints the hit rate of every cached contract looked up so far, by address
+    void report(std::ostream& out) const;
+
+  private:
+    cache::lru_cache<PrecompileInput, std::optional<Bytes>> cache_;
+    std::array<Stats, precompiled::kNumOfIstanbulContracts> stats_{};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_EXECUTION_PRECOMPILE_CACHE_H_
@@ -0,0 +1,78 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include "precompile_cache.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+#include <sstream>
+
+namespace silkworm {
+
+TEST_CASE("Precompile cache") {
+    constexpr size_t kIdentity{3};
+    constexpr size_t kExpmod{4};
+    constexpr size_t kBlake2F{8};
+
+    // 3^(p - 2) mod p with p of secp256k1
+    const Bytes expmod_in{
+        *from_hex("0000000000000000000000000000000000000000000000000000000000000001"
+                  "0000000000000000000000000000000000000000000000000000000000000020"
+                  "0000000000000000000000000000000000000000000000000000000000000020"
+                  "03"
+                  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2d"
+                  "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f")};
+    const std::optional<Bytes> expected{precompiled::expmod_run(expmod_in)};
+    REQUIRE(expected);
+
+    PrecompileCache cache{2};
+    CHECK(cache.run(kExpmod, expmod_in) == expected);
+    CHECK(cache.stats(kExpmod).misses == 1);
+    CHECK(cache.stats(kExpmod).hits == 0);
+    CHECK(cache.run(kExpmod, expmod_in) == expected);
+    CHECK(cache.stats(kExpmod).misses == 1);
+    CHECK(cache.stats(kExpmod).hits == 1);
+
+    // The same input for another contract
+    CHECK(!cache.run(kBlake2F, expmod_in));
+    CHECK(cache.stats(kBlake2F).misses == 1);
+
+    // Failures are cached too
+    CHECK(!cache.run(kBlake2F, expmod_in));
+    CHECK(cache.stats(kBlake2F).hits == 1);
+    CHECK(cache.stats(kExpmod).hits == 1);
+
+    // Not worth caching
+    CHECK(!PrecompileCache::is_cached(kIdentity));
+    CHECK(cache.run(kIdentity, expmod_in) == expmod_in);
+    CHECK(cache.stats(kIdentity).hits + cache.stats(kIdentity).misses == 0);
+
+    // Least recently used entries are evicted
+    Bytes other_in{expmod_in};
+    other_in.back() = 0x2b;
+    CHECK(cache.run(kExpmod, other_in) == precompiled::expmod_run(other_in));
+    CHECK(cache.run(kExpmod, expmod_in) == expected);
+    CHECK(cache.stats(kExpmod).misses == 3);
+
+    std::ostringstream report;
+    cache.report(report);
+    CHECK(report.str() ==
+          "Precompile 0x5: 1 hits of 4 lookups (25%)\n"
+          "Precompile 0x9: 1 hits of 2 lookups (50%)\n");
+}
+
+}  // namespace silkworm
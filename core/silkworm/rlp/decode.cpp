@@ -153,6 +153,20 @@ DecodingResult decode(ByteView& from, Bytes& to) noexcept {
     return DecodingResult::kOk;
 }
 
+template <>
+DecodingResult decode(ByteView& from, ByteView& to) noexcept {
+    auto [h, err]{decode_header(from)};
+    if (err != DecodingResult::kOk) {
+        return err;
+    }
+    if (h.list) {
+        return DecodingResult::kUnexpectedList;
+    }
+    to = from.substr(0, h.payload_length);
+    from.remove_prefix(h.payload_length);
+    return DecodingResult::kOk;
+}
+
 template <>
 DecodingResult decode(ByteView& from, uint64_t& to) noexcept {
     auto [h, err1]{decode_header(from)};
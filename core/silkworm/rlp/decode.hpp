@@ -46,6 +46,10 @@ DecodingResult decode(ByteView& from, T& to) noexcept;
 template <>
 DecodingResult decode(ByteView& from, Bytes& to) noexcept;
 
+// Payload of a string, pointing into from rather than copied
+template <>
+DecodingResult decode(ByteView& from, ByteView& to) noexcept;
+
 template <>
 DecodingResult decode(ByteView& from, uint64_t& to) noexcept;
 
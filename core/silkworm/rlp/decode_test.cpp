@@ -57,6 +57,15 @@ TEST_CASE("RLP decoding") {
         CHECK(to_hex(decode_success<Bytes>("8D6F62636465666768696A6B6C6D")) == "6f62636465666768696a6b6c6d");
 
         CHECK(decode_failure<Bytes>("C0") == DecodingResult::kUnexpectedList);
+
+        Bytes bytes{*from_hex("8D6F62636465666768696A6B6C6D")};
+        ByteView view{bytes};
+        ByteView payload;
+        REQUIRE(decode(view, payload) == DecodingResult::kOk);
+        CHECK(view.empty());
+        CHECK(payload.data() == &bytes[1]);
+        CHECK(to_hex(payload) == "6f62636465666768696a6b6c6d");
+        CHECK(decode_failure<ByteView>("C0") == DecodingResult::kUnexpectedList);
     }
 
     SECTION("uint64") {
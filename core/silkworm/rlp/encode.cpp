@@ -33,6 +33,25 @@ void encode_header(Bytes& to, Header header) {
     }
 }
 
+ReverseEncoder::ReverseEncoder(Bytes& to, size_t length) {
+    const size_t old_length{to.length()};
+    to.resize(old_length + length);
+    begin_ = to.data() + old_length;
+    pos_ = &to[0] + to.length();
+}
+
+void ReverseEncoder::prepend_header(Header header) noexcept {
+    if (header.payload_length < 56) {
+        uint8_t code{header.list ? kEmptyListCode : kEmptyStringCode};
+        prepend(static_cast<uint8_t>(code + header.payload_length));
+    } else {
+        ByteView len_be{big_endian(header.payload_length)};
+        uint8_t code = header.list ? '\xF7' : '\xB7';
+        prepend(len_be);
+        prepend(static_cast<uint8_t>(code + len_be.length()));
+    }
+}
+
 size_t length_of_length(uint64_t payload_length) {
     if (payload_length < 56) {
         return 1;
@@ -53,6 +72,18 @@ void encode(Bytes& to, ByteView s) {
     to.append(s);
 }
 
+void encode(ReverseEncoder& to, const evmc::bytes32& hash) noexcept {
+    to.prepend(full_view(hash));
+    to.prepend(static_cast<uint8_t>(kEmptyStringCode + kHashLength));
+}
+
+void encode(ReverseEncoder& to, ByteView s) noexcept {
+    to.prepend(s);
+    if (s.length() != 1 || s[0] >= kEmptyStringCode) {
+        to.prepend_header({false, s.length()});
+    }
+}
+
 size_t length(ByteView s) {
     size_t len{s.length()};
     if (s.length() != 1 || s[0] >= kEmptyStringCode) {
@@ -73,6 +104,18 @@ void encode(Bytes& to, uint64_t n) {
     }
 }
 
+void encode(ReverseEncoder& to, uint64_t n) noexcept {
+    if (n == 0) {
+        to.prepend(kEmptyStringCode);
+    } else if (n < kEmptyStringCode) {
+        to.prepend(static_cast<uint8_t>(n));
+    } else {
+        ByteView be{big_endian(n)};
+        to.prepend(be);
+        to.prepend(static_cast<uint8_t>(kEmptyStringCode + be.length()));
+    }
+}
+
 size_t length(uint64_t n) noexcept {
     if (n < kEmptyStringCode) {
         return 1;
@@ -93,6 +136,18 @@ void encode(Bytes& to, const intx::uint256& n) {
     }
 }
 
+void encode(ReverseEncoder& to, const intx::uint256& n) noexcept {
+    if (n == 0) {
+        to.prepend(kEmptyStringCode);
+    } else if (n < kEmptyStringCode) {
+        to.prepend(intx::narrow_cast<uint8_t>(n));
+    } else {
+        ByteView be{big_endian(n)};
+        to.prepend(be);
+        to.prepend(static_cast<uint8_t>(kEmptyStringCode + be.length()));
+    }
+}
+
 size_t length(const intx::uint256& n) {
     if (n < kEmptyStringCode) {
         return 1;
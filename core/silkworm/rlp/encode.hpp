@@ -21,6 +21,8 @@
 #define SILKWORM_RLP_ENCODE_H_
 
 #include <array>
+#include <cassert>
+#include <cstring>
 #include <gsl/span>
 #include <intx/intx.hpp>
 #include <optional>
@@ -47,6 +49,40 @@ namespace rlp {
 
     void encode_header(Bytes& to, Header header);
 
+    // Writes an encoding back to front into a buffer of its exact length, as given by the length functions.
+    // The header of a list is thus written right after its payload, when the payload length is known,
+    // rather than the lengths of all nested lists being calculated again for every header.
+    class ReverseEncoder {
+      public:
+        // Grows to by length bytes, to be filled by the encoder
+        ReverseEncoder(Bytes& to, size_t length);
+
+        // Start of what has been written so far
+        const uint8_t* position() const noexcept { return pos_; }
+
+        void prepend(ByteView bytes) noexcept {
+            assert(static_cast<size_t>(pos_ - begin_) >= bytes.length());  // Length functions undercounted
+            pos_ -= bytes.length();
+            std::memcpy(pos_, bytes.data(), bytes.length());
+        }
+
+        void prepend(uint8_t byte) noexcept {
+            assert(pos_ > begin_);
+            *--pos_ = byte;
+        }
+
+        void prepend_header(Header header) noexcept;
+
+        // Header of the list whose payload was written from the current position to payload_end
+        void prepend_list_header(const uint8_t* payload_end) noexcept {
+            prepend_header({true, static_cast<uint64_t>(payload_end - pos_)});
+        }
+
+      private:
+        const uint8_t* begin_;
+        uint8_t* pos_;
+    };
+
     void encode(Bytes& to, const evmc::bytes32&);
     void encode(Bytes& to, ByteView);
     void encode(Bytes& to, uint64_t);
@@ -75,6 +111,31 @@ namespace rlp {
     void encode(Bytes& to, const Receipt&);
     void encode(Bytes& to, const Transaction&);
 
+    void encode(ReverseEncoder& to, const evmc::bytes32&) noexcept;
+    void encode(ReverseEncoder& to, ByteView) noexcept;
+    void encode(ReverseEncoder& to, uint64_t) noexcept;
+    void encode(ReverseEncoder& to, const intx::uint256&) noexcept;
+
+    template <size_t N>
+    void encode(ReverseEncoder& to, const uint8_t (&bytes)[N]) noexcept {
+        static_assert(N <= 55, "Complex RLP length encoding not supported");
+        to.prepend(ByteView{bytes, N});
+        to.prepend(static_cast<uint8_t>(kEmptyStringCode + N));
+    }
+
+    template <size_t N>
+    void encode(ReverseEncoder& to, const std::array<uint8_t, N>& bytes) noexcept {
+        static_assert(N <= 55, "Complex RLP length encoding not supported");
+        to.prepend(ByteView{bytes.data(), N});
+        to.prepend(static_cast<uint8_t>(kEmptyStringCode + N));
+    }
+
+    void encode(ReverseEncoder& to, const BlockBody&) noexcept;
+    void encode(ReverseEncoder& to, const BlockHeader&) noexcept;
+    void encode(ReverseEncoder& to, const Log&) noexcept;
+    void encode(ReverseEncoder& to, const Receipt&) noexcept;
+    void encode(ReverseEncoder& to, const Transaction&) noexcept;
+
     size_t length_of_length(uint64_t payload_length);
 
     inline size_t length(const evmc::bytes32&) { return kHashLength + 1; }
@@ -83,8 +144,10 @@ namespace rlp {
     size_t length(uint64_t) noexcept;
     size_t length(const intx::uint256&);
 
+    size_t length(const BlockBody&);
     size_t length(const BlockHeader&);
     size_t length(const Log&);
+    size_t length(const Receipt&);
     size_t length(const Transaction&);
 
     template <class T>
@@ -97,15 +160,20 @@ namespace rlp {
     }
 
     template <class T>
-    void encode(Bytes& to, const std::vector<T>& v) {
-        Header h{true, 0};
-        for (const T& x : v) {
-            h.payload_length += length(x);
-        }
-        encode_header(to, h);
-        for (const T& x : v) {
-            encode(to, x);
+    void encode(ReverseEncoder& to, const std::vector<T>& v) noexcept {
+        const uint8_t* payload_end{to.position()};
+        for (auto it{v.rbegin()}; it != v.rend(); ++it) {
+            encode(to, *it);
         }
+        to.prepend_list_header(payload_end);
+    }
+
+    template <class T>
+    void encode(Bytes& to, const std::vector<T>& v) {
+        const size_t old_length{to.length()};
+        ReverseEncoder encoder{to, length(v)};
+        encode(encoder, v);
+        assert(encoder.position() == to.data() + old_length);
     }
 
     // Returns a view of a thread-local buffer,
@@ -74,6 +74,15 @@ TEST_CASE("RLP encoding") {
     SECTION("vectors") {
         CHECK(to_hex(encoded(std::vector<uint64_t>{})) == "c0");
         CHECK(to_hex(encoded(std::vector<uint64_t>{0xFFCCB5, 0xFFC0B5})) == "c883ffccb583ffc0b5");
+
+        // Long & nested lists, appended to what is already there
+        Bytes rlp{*from_hex("abcd")};
+        rlp::encode(rlp, std::vector<std::vector<uint64_t>>{{}, std::vector<uint64_t>(30, 0x400)});
+        std::string expected{"abcdf85dc0f85a"};
+        for (size_t i{0}; i < 30; ++i) {
+            expected += "820400";
+        }
+        CHECK(to_hex(rlp) == expected);
     }
 }
 }  // namespace silkworm
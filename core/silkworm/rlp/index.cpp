@@ -0,0 +1,136 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "index.hpp"
+
+#include <array>
+
+namespace silkworm::rlp {
+
+// What the first byte of an item tells about it
+struct Prefix {
+    uint8_t header_length{0};   // 0 for a byte in the [0x00, 0x7f] range, which is its own payload
+    uint8_t payload_length{0};  // unless long_form
+    bool list{false};
+    bool long_form{false};  // payload length given by the following bytes
+};
+
+static constexpr std::array<Prefix, 256> make_prefixes() {
+    std::array<Prefix, 256> prefixes{};
+    for (size_t b{0}; b < 256; ++b) {
+        Prefix& p{prefixes[b]};
+        if (b < 0x80) {
+            p.payload_length = 1;
+        } else if (b < 0xB8) {
+            p.header_length = 1;
+            p.payload_length = static_cast<uint8_t>(b - 0x80);
+        } else if (b < 0xC0) {
+            p.long_form = true;
+        } else if (b < 0xF8) {
+            p.header_length = 1;
+            p.payload_length = static_cast<uint8_t>(b - 0xC0);
+            p.list = true;
+        } else {
+            p.list = true;
+            p.long_form = true;
+        }
+    }
+    return prefixes;
+}
+
+static constexpr std::array<Prefix, 256> kPrefixes{make_prefixes()};
+
+DecodingResult StructuralIndex::build(ByteView from) noexcept {
+    buffer_ = from;
+    items_.clear();
+    open_lists_.clear();
+
+    size_t pos{0};
+    size_t end{from.length()};  // of the innermost open list
+    while (true) {
+        while (pos == end && !open_lists_.empty()) {
+            items_[open_lists_.back()].end = static_cast<uint32_t>(items_.size());
+            open_lists_.pop_back();
+            if (open_lists_.empty()) {
+                end = from.length();
+            } else {
+                const Item& parent{items_[open_lists_.back()]};
+                end = parent.payload_offset + parent.payload_length;
+            }
+        }
+        if (pos == end) {
+            break;
+        }
+
+        const Prefix& prefix{kPrefixes[from[pos]]};
+        Item& item{items_.emplace_back()};
+        item.offset = pos;
+        item.list = prefix.list;
+        if (!prefix.long_form) {
+            item.payload_offset = pos + prefix.header_length;
+            item.payload_length = prefix.payload_length;
+            if (prefix.payload_length == 1 && prefix.header_length == 1 && !prefix.list) {
+                if (item.payload_offset == end) {
+                    return DecodingResult::kInputTooShort;
+                }
+                if (from[item.payload_offset] < 0x80) {
+                    return DecodingResult::kNonCanonicalSingleByte;
+                }
+            }
+        } else {
+            ByteView view{from.substr(pos, end - pos)};
+            auto [h, err]{decode_header(view)};
+            if (err != DecodingResult::kOk) {
+                return err;
+            }
+            item.payload_offset = end - view.length();
+            item.payload_length = h.payload_length;
+        }
+        if (item.payload_length > end - item.payload_offset) {
+            return DecodingResult::kInputTooShort;
+        }
+
+        if (item.list) {
+            open_lists_.push_back(items_.size() - 1);
+            pos = item.payload_offset;
+            end = item.payload_offset + item.payload_length;
+        } else {
+            item.end = static_cast<uint32_t>(items_.size());
+            pos = item.payload_offset + item.payload_length;
+        }
+    }
+
+    return DecodingResult::kOk;
+}
+
+size_t StructuralIndex::child(size_t list, size_t n) const noexcept {
+    const size_t last{items_[list].end};
+    size_t i{list + 1};
+    for (; n > 0 && i < last; --n) {
+        i = items_[i].end;
+    }
+    return i < last ? i : npos;
+}
+
+size_t StructuralIndex::num_children(size_t list) const noexcept {
+    size_t n{0};
+    for (size_t i{list + 1}; i < items_[list].end; i = items_[i].end) {
+        ++n;
+    }
+    return n;
+}
+
+}  // namespace silkworm::rlp
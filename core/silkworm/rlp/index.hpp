@@ -0,0 +1,74 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_RLP_INDEX_H_
+#define SILKWORM_RLP_INDEX_H_
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/rlp/decode.hpp>
+#include <vector>
+
+namespace silkworm::rlp {
+
+// Structural index of RLP: every item at every nesting level, in the order they appear.
+// Building the index validates the framing of the whole buffer in one iterative pass,
+// classifying prefixes through a table; the items of a list are then reached by lookups
+// rather than by decoding headers again.
+class StructuralIndex {
+  public:
+    static constexpr size_t npos{SIZE_MAX};
+
+    struct Item {
+        size_t offset{0};  // of the header
+        size_t payload_offset{0};
+        size_t payload_length{0};
+        uint32_t end{0};  // index of the next item that isn't nested within this one
+        bool list{false};
+    };
+
+    // Indexes a buffer made of a sequence of items, e.g. a single block body.
+    // The buffer must outlive the index, which may be built again over another buffer.
+    DecodingResult build(ByteView from) noexcept;
+
+    size_t size() const noexcept { return items_.size(); }
+
+    const Item& operator[](size_t i) const noexcept { return items_[i]; }
+
+    ByteView payload(size_t i) const noexcept {
+        return buffer_.substr(items_[i].payload_offset, items_[i].payload_length);
+    }
+
+    // Whole encoding of an item, header included
+    ByteView encoding(size_t i) const noexcept {
+        const Item& item{items_[i]};
+        return buffer_.substr(item.offset, item.payload_offset - item.offset + item.payload_length);
+    }
+
+    // Index of the n-th element of a list, or npos if there's no such element
+    size_t child(size_t list, size_t n) const noexcept;
+
+    // Number of elements of a list
+    size_t num_children(size_t list) const noexcept;
+
+  private:
+    ByteView buffer_;
+    std::vector<Item> items_;
+    std::vector<size_t> open_lists_;
+};
+
+}  // namespace silkworm::rlp
+
+#endif  // SILKWORM_RLP_INDEX_H_
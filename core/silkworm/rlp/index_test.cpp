@@ -0,0 +1,110 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "index.hpp"
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <silkworm/common/util.hpp>
+#include <silkworm/types/block.hpp>
+
+namespace silkworm::rlp {
+
+// Reference validation through recursive decoding of the headers
+static DecodingResult validate(ByteView from) {
+    while (!from.empty()) {
+        auto [h, err]{decode_header(from)};
+        if (err != DecodingResult::kOk) {
+            return err;
+        }
+        if (h.list) {
+            if (DecodingResult err{validate(from.substr(0, h.payload_length))}; err != DecodingResult::kOk) {
+                return err;
+            }
+        }
+        from.remove_prefix(h.payload_length);
+    }
+    return DecodingResult::kOk;
+}
+
+static DecodingResult index_hex(std::string_view hex) {
+    Bytes bytes{*from_hex(hex)};
+    StructuralIndex index;
+    return index.build(bytes);
+}
+
+TEST_CASE("RLP structural index") {
+    BlockBody body;
+    body.transactions.resize(3);
+    for (size_t i{0}; i < body.transactions.size(); ++i) {
+        body.transactions[i].nonce = i * 1000;
+        body.transactions[i].gas_price = 20 * kGiga;
+        body.transactions[i].to = 0x5df9b87991262f6ba471f09758cde1c0fc1de734_address;
+        body.transactions[i].data = Bytes(i * 30, 0xab);
+        body.transactions[i].r = 1;
+        body.transactions[i].s = 2;
+    }
+    body.ommers.resize(1);
+    body.ommers[0].number = 1'000'013;
+
+    Bytes rlp{};
+    encode(rlp, body);
+
+    StructuralIndex index;
+    REQUIRE(index.build(rlp) == DecodingResult::kOk);
+    REQUIRE(index.size() > 0);
+    CHECK(index[0].list);
+    CHECK(index[0].end == index.size());
+    CHECK(index.encoding(0) == rlp);
+    REQUIRE(index.num_children(0) == 2);
+
+    const size_t transactions{index.child(0, 0)};
+    REQUIRE(index.num_children(transactions) == body.transactions.size());
+    for (size_t i{0}; i < body.transactions.size(); ++i) {
+        const size_t txn{index.child(transactions, i)};
+        Bytes txn_rlp{};
+        encode(txn_rlp, body.transactions[i]);
+        CHECK(index.encoding(txn) == txn_rlp);
+        CHECK(read_uint64(index.payload(index.child(txn, 0))).first == body.transactions[i].nonce);
+        CHECK(index.payload(index.child(txn, 5)) == body.transactions[i].data);
+        CHECK(index.child(txn, 9) == StructuralIndex::npos);
+    }
+    CHECK(index.child(transactions, body.transactions.size()) == StructuralIndex::npos);
+
+    const size_t ommers{index.child(0, 1)};
+    REQUIRE(index.num_children(ommers) == 1);
+    CHECK(read_uint64(index.payload(index.child(index.child(ommers, 0), 8))).first == 1'000'013);
+
+    CHECK(index_hex("") == DecodingResult::kOk);
+    CHECK(index_hex("C0C180") == DecodingResult::kOk);
+    CHECK(index_hex("81") == DecodingResult::kInputTooShort);
+    CHECK(index_hex("8105") == DecodingResult::kNonCanonicalSingleByte);
+    CHECK(index_hex("B8020004") == DecodingResult::kNonCanonicalSize);
+    CHECK(index_hex("C28301") == DecodingResult::kInputTooShort);
+    CHECK(index_hex("C3C28301") == DecodingResult::kInputTooShort);
+
+    // Same verdict as recursive decoding over corrupted encodings
+    std::mt19937_64 rng{1};
+    for (size_t i{0}; i < 2'000; ++i) {
+        Bytes corrupted{rlp};
+        for (size_t j{0}; j < 1 + i % 3; ++j) {
+            corrupted[rng() % corrupted.length()] = static_cast<uint8_t>(rng());
+        }
+        REQUIRE(index.build(corrupted) == validate(corrupted));
+    }
+}
+
+}  // namespace silkworm::rlp
@@ -17,19 +17,20 @@
 #include "memory_buffer.hpp"
 
 #include <ethash/keccak.hpp>
-#include <map>
+#include <algorithm>
+#include <silkworm/common/parallel_for_each.hpp>
 #include <silkworm/common/util.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
 #include <silkworm/rlp/encode.hpp>
-#include <silkworm/trie/hash_builder.hpp>
 
 namespace silkworm {
 
 std::optional<Account> MemoryBuffer::read_account(const evmc::address& address) const noexcept {
-    auto it{accounts_.find(address)};
-    if (it == accounts_.end()) {
+    auto it{account_ids_.find(address)};
+    if (it == account_ids_.end()) {
         return std::nullopt;
     }
-    return it->second;
+    return accounts_[it->second].current;
 }
 
 Bytes MemoryBuffer::read_code(const evmc::bytes32& code_hash) const noexcept {
@@ -40,29 +41,38 @@ Bytes MemoryBuffer::read_code(const evmc::bytes32& code_hash) const noexcept {
     return it->second;
 }
 
+const MemoryBuffer::Storage* MemoryBuffer::find_storage(const evmc::address& address,
+                                                        uint64_t incarnation) const noexcept {
+    auto it1{account_ids_.find(address)};
+    if (it1 == account_ids_.end()) {
+        return nullptr;
+    }
+    auto it2{storage_.find({it1->second, incarnation})};
+    if (it2 == storage_.end()) {
+        return nullptr;
+    }
+    return &it2->second;
+}
+
 evmc::bytes32 MemoryBuffer::read_storage(const evmc::address& address, uint64_t incarnation,
                                          const evmc::bytes32& location) const noexcept {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return {};
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
+    const Storage* storage{find_storage(address, incarnation)};
+    if (!storage) {
         return {};
     }
-    auto it3{it2->second.find(location)};
-    if (it3 == it2->second.end()) {
+    auto it{storage->slots.find(location)};
+    if (it == storage->slots.end()) {
         return {};
     }
-    return it3->second;
+    return it->second;
 }
 
 uint64_t MemoryBuffer::previous_incarnation(const evmc::address& address) const noexcept {
-    auto it{prev_incarnations_.find(address)};
-    if (it == prev_incarnations_.end()) {
+    auto it{account_ids_.find(address)};
+    if (it == account_ids_.end()) {
         return 0;
     }
-    return it->second;
+    return accounts_[it->second].prev_incarnation;
 }
 
 std::optional<BlockHeader> MemoryBuffer::read_header(uint64_t block_number,
@@ -151,21 +161,49 @@ void MemoryBuffer::insert_receipts(uint64_t, const std::vector<Receipt>&) {}
 
 void MemoryBuffer::begin_block(uint64_t block_number) {
     block_number_ = block_number;
-    account_changes_.erase(block_number);
-    storage_changes_.erase(block_number);
+    changes_.erase(block_number);
+}
+
+MemoryBuffer::AccountId MemoryBuffer::intern(const evmc::address& address) {
+    auto [it, inserted]{account_ids_.try_emplace(address)};
+    if (inserted) {
+        it->second = accounts_.size();
+        accounts_.push_back({address, std::nullopt, 0, std::nullopt});
+    }
+    return it->second;
+}
+
+void MemoryBuffer::set_account(AccountId id, const std::optional<Account>& account) {
+    std::optional<Account>& current{accounts_[id].current};
+    number_of_accounts_ += account.has_value();
+    number_of_accounts_ -= current.has_value();
+    current = account;
+
+    changed_accounts_.push_back(id);
+    state_root_.reset();
+}
+
+void MemoryBuffer::set_storage(const StorageKey& key, const evmc::bytes32& location, const evmc::bytes32& value) {
+    Storage& storage{storage_[key]};
+    if (is_zero(value)) {
+        storage.slots.erase(location);
+    } else {
+        storage.slots[location] = value;
+    }
+
+    storage.changed_locations.push_back(location);
+    changed_accounts_.push_back(key.account);
+    state_root_.reset();
 }
 
 void MemoryBuffer::update_account(const evmc::address& address, std::optional<Account> initial,
                                   std::optional<Account> current) {
-    account_changes_[block_number_][address] = initial;
+    const AccountId id{intern(address)};
+    changes_[block_number_].accounts.emplace_back(id, initial);
 
-    if (current) {
-        accounts_[address] = *current;
-    } else {
-        accounts_.erase(address);
-        if (initial) {
-            prev_incarnations_[address] = initial->incarnation;
-        }
+    set_account(id, current);
+    if (!current && initial) {
+        accounts_[id].prev_incarnation = initial->incarnation;
     }
 }
 
@@ -175,110 +213,143 @@ void MemoryBuffer::update_account_code(const evmc::address&, uint64_t, const evm
 
 void MemoryBuffer::update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
                                   const evmc::bytes32& initial, const evmc::bytes32& current) {
-    storage_changes_[block_number_][address][incarnation][location] = initial;
+    const StorageKey key{intern(address), incarnation};
+    changes_[block_number_].storage.emplace_back(key, location, initial);
 
-    if (is_zero(current)) {
-        storage_[address][incarnation].erase(location);
-    } else {
-        storage_[address][incarnation][location] = current;
-    }
+    set_storage(key, location, current);
 }
 
 void MemoryBuffer::unwind_state_changes(uint64_t block_number) {
-    for (const auto& [address, account] : account_changes_[block_number]) {
-        if (account) {
-            accounts_[address] = *account;
-        } else {
-            accounts_.erase(address);
-        }
+    auto it{changes_.find(block_number)};
+    if (it == changes_.end()) {
+        return;
     }
+    const ChangeSet& changes{it->second};
 
-    for (const auto& [address, storage1] : storage_changes_[block_number]) {
-        for (const auto& [incarnation, storage2] : storage1) {
-            for (const auto& [location, value] : storage2) {
-                if (is_zero(value)) {
-                    storage_[address][incarnation].erase(location);
-                } else {
-                    storage_[address][incarnation][location] = value;
-                }
-            }
-        }
+    // Backwards, so that the earliest initial value of the block is the one left
+    for (auto change{changes.accounts.rbegin()}; change != changes.accounts.rend(); ++change) {
+        set_account(change->first, change->second);
+    }
+    for (auto change{changes.storage.rbegin()}; change != changes.storage.rend(); ++change) {
+        const auto& [key, location, value]{*change};
+        set_storage(key, location, value);
     }
 }
 
-size_t MemoryBuffer::number_of_accounts() const { return accounts_.size(); }
+size_t MemoryBuffer::number_of_accounts() const { return number_of_accounts_; }
 
 size_t MemoryBuffer::storage_size(const evmc::address& address, uint64_t incarnation) const {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return 0;
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
-        return 0;
-    }
-
-    return it2->second.size();
+    const Storage* storage{find_storage(address, incarnation)};
+    return storage ? storage->slots.size() : 0;
 }
 
 // https://eth.wiki/fundamentals/patricia-tree#storage-trie
-evmc::bytes32 MemoryBuffer::account_storage_root(const evmc::address& address, uint64_t incarnation) const {
-    auto it1{storage_.find(address)};
-    if (it1 == storage_.end()) {
-        return kEmptyRoot;
-    }
-    auto it2{it1->second.find(incarnation)};
-    if (it2 == it1->second.end()) {
-        return kEmptyRoot;
-    }
+// Below these sizes extra threads cost more than they save
+static constexpr size_t kMinParallelAccounts{1024};
+static constexpr size_t kMinParallelStorage{4096};
 
-    const auto& storage{it2->second};
+// Keys of the leaves are hashed this many at a time, see crypto::keccak256_batch
+static constexpr size_t kKeccakBatchSize{32};
 
-    if (storage.empty()) {
-        return kEmptyRoot;
-    }
+static size_t num_keccak_batches(size_t n) { return (n + kKeccakBatchSize - 1) / kKeccakBatchSize; }
 
-    std::map<evmc::bytes32, Bytes> storage_rlp;
-    Bytes rlp;
-    for (const auto& [location, value] : storage) {
-        ethash::hash256 hash{keccak256(full_view(location))};
-        rlp.clear();
-        rlp::encode(rlp, zeroless_view(value));
-        storage_rlp[to_bytes32(full_view(hash.bytes))] = rlp;
-    }
+evmc::bytes32 MemoryBuffer::storage_root(const Storage& storage, unsigned num_threads) {
+    auto& changes{storage.changed_locations};
+    std::sort(changes.begin(), changes.end());
+    changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
 
-    auto it{storage_rlp.cbegin()};
-    trie::HashBuilder hb{full_view(it->first), it->second};
-    for (++it; it != storage_rlp.cend(); ++it) {
-        hb.add(full_view(it->first), it->second);
+    Bytes rlp;
+    for (size_t begin{0}; begin < changes.size(); begin += kKeccakBatchSize) {
+        const size_t end{std::min(begin + kKeccakBatchSize, changes.size())};
+        ByteView keys[kKeccakBatchSize];
+        for (size_t i{begin}; i < end; ++i) {
+            keys[i - begin] = full_view(changes[i]);
+        }
+        ethash::hash256 hashes[kKeccakBatchSize];
+        crypto::keccak256_batch({hashes, end - begin}, {keys, end - begin});
+
+        for (size_t i{begin}; i < end; ++i) {
+            const evmc::bytes32 hashed_location{to_bytes32(full_view(hashes[i - begin].bytes))};
+            if (auto it{storage.slots.find(changes[i])}; it != storage.slots.end()) {
+                rlp.clear();
+                rlp::encode(rlp, zeroless_view(it->second));
+                storage.trie.put(hashed_location, rlp);
+            } else {
+                storage.trie.erase(hashed_location);
+            }
+        }
     }
+    changes.clear();
 
-    return hb.root_hash();
+    return storage.trie.root_hash(num_threads);
 }
 
 evmc::bytes32 MemoryBuffer::state_root_hash() const {
-    if (accounts_.empty()) {
-        return kEmptyRoot;
+    if (state_root_) {
+        return *state_root_;
     }
 
-    std::map<evmc::bytes32, Bytes> account_rlp;
-    Bytes rlp;
-    for (const auto& [address, account] : accounts_) {
-        ethash::hash256 hash{keccak256(full_view(address))};
-        Account copy{account};
-        copy.storage_root = account_storage_root(address, account.incarnation);
-        rlp.clear();
-        rlp::encode(rlp, copy);
-        account_rlp[to_bytes32(full_view(hash.bytes))] = rlp;
+    auto& changes{changed_accounts_};
+    std::sort(changes.begin(), changes.end());
+    changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+    const unsigned num_threads{changes.size() >= kMinParallelAccounts ? hardware_threads() : 1};
+
+    // Large storage tries are brought up to date one at a time with all threads,
+    // the others by the thread processing their account
+    std::vector<const Storage*> storages(changes.size());
+    for (size_t i{0}; i < changes.size(); ++i) {
+        const AccountEntry& entry{accounts_[changes[i]]};
+        if (!entry.current) {
+            continue;
+        }
+        if (auto it{storage_.find({changes[i], entry.current->incarnation})}; it != storage_.end()) {
+            storages[i] = &it->second;
+            if (it->second.slots.size() >= kMinParallelStorage) {
+                storage_root(it->second, hardware_threads());
+            }
+        }
     }
 
-    auto it{account_rlp.cbegin()};
-    trie::HashBuilder hb{full_view(it->first), it->second};
-    for (++it; it != account_rlp.cend(); ++it) {
-        hb.add(full_view(it->first), it->second);
+    // Leaves of the changed accounts; addresses are hashed once and for all
+    std::vector<Bytes> values(changes.size());
+    parallel_for_each(num_keccak_batches(changes.size()), num_threads, [&](size_t batch) {
+        const size_t begin{batch * kKeccakBatchSize};
+        const size_t end{std::min(begin + kKeccakBatchSize, changes.size())};
+        ByteView keys[kKeccakBatchSize];
+        const AccountEntry* unhashed[kKeccakBatchSize];
+        size_t num_unhashed{0};
+        for (size_t i{begin}; i < end; ++i) {
+            const AccountEntry& entry{accounts_[changes[i]]};
+            if (entry.current) {
+                Account copy{*entry.current};
+                copy.storage_root = storages[i] ? storage_root(*storages[i], /*num_threads=*/1) : kEmptyRoot;
+                rlp::encode(values[i], copy);
+            }
+            if (!entry.hashed_address) {
+                keys[num_unhashed] = full_view(entry.address);
+                unhashed[num_unhashed++] = &entry;
+            }
+        }
+        ethash::hash256 hashes[kKeccakBatchSize];
+        crypto::keccak256_batch({hashes, num_unhashed}, {keys, num_unhashed});
+        for (size_t i{0}; i < num_unhashed; ++i) {
+            unhashed[i]->hashed_address = to_bytes32(full_view(hashes[i].bytes));
+        }
+    });
+
+    for (size_t i{0}; i < changes.size(); ++i) {
+        const AccountEntry& entry{accounts_[changes[i]]};
+        if (entry.current) {
+            account_trie_.put(*entry.hashed_address, std::move(values[i]));
+        } else {
+            account_trie_.erase(*entry.hashed_address);
+        }
     }
+    changes.clear();
 
-    return hb.root_hash();
+    state_root_ = account_trie_.root_hash(num_threads);
+    return *state_root_;
 }
 
 }  // namespace silkworm
@@ -17,13 +17,19 @@
 #ifndef SILKWORM_STATE_MEMORY_BUFFER_H_
 #define SILKWORM_STATE_MEMORY_BUFFER_H_
 
+#include <silkworm/common/flat_hash_map.hpp>
 #include <silkworm/state/buffer.hpp>
+#include <silkworm/trie/cached_trie.hpp>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 namespace silkworm {
 
 /// MemoryBuffer holds all state in memory.
+/// Accounts, storage & change sets live in flat hash maps keyed by interned addresses.
+/// The account & storage tries are cached, so state_root_hash only rehashes what changed since its last call
+/// (which makes it unsafe to call concurrently).
 class MemoryBuffer : public StateBuffer {
   public:
     std::optional<Account> read_account(const evmc::address& address) const noexcept override;
@@ -75,26 +81,58 @@ class MemoryBuffer : public StateBuffer {
     size_t storage_size(const evmc::address& address, uint64_t incarnation) const;
 
   private:
-    // address -> initial value
-    using AccountChanges = std::unordered_map<evmc::address, std::optional<Account>>;
+    // Every address ever written is interned : its id indexes accounts_
+    using AccountId = uint64_t;
 
-    // address -> incarnation -> location -> initial value
-    using StorageChanges =
-        std::unordered_map<evmc::address,
-                           std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>;
+    struct AccountEntry {
+        evmc::address address;
+        std::optional<Account> current;
+        uint64_t prev_incarnation{0};
+        mutable std::optional<evmc::bytes32> hashed_address;  // filled in by state_root_hash
+    };
 
-    evmc::bytes32 account_storage_root(const evmc::address& address, uint64_t incarnation) const;
+    struct StorageKey {
+        AccountId account;
+        uint64_t incarnation;
 
-    std::unordered_map<evmc::address, Account> accounts_;
+        bool operator==(const StorageKey& other) const {
+            return account == other.account && incarnation == other.incarnation;
+        }
+    };
 
-    // hash -> code
-    std::unordered_map<evmc::bytes32, Bytes> code_;
+    struct Storage {
+        // location -> value
+        FlatHashMap<evmc::bytes32, evmc::bytes32> slots;
+
+        // Hashed storage trie, brought up to date with the changed locations by storage_root
+        mutable trie::CachedTrie trie;
+        mutable std::vector<evmc::bytes32> changed_locations;
+    };
+
+    // Initial values, replayed backwards by unwind_state_changes
+    struct ChangeSet {
+        std::vector<std::pair<AccountId, std::optional<Account>>> accounts;
+        std::vector<std::tuple<StorageKey, evmc::bytes32, evmc::bytes32>> storage;  // key, location, initial value
+    };
+
+    AccountId intern(const evmc::address& address);
+
+    const Storage* find_storage(const evmc::address& address, uint64_t incarnation) const noexcept;
+
+    void set_account(AccountId id, const std::optional<Account>& account);
 
-    std::unordered_map<evmc::address, uint64_t> prev_incarnations_;
+    void set_storage(const StorageKey& key, const evmc::bytes32& location, const evmc::bytes32& value);
 
-    // address -> incarnation -> location -> value
-    std::unordered_map<evmc::address, std::unordered_map<uint64_t, std::unordered_map<evmc::bytes32, evmc::bytes32>>>
-        storage_;
+    static evmc::bytes32 storage_root(const Storage& storage, unsigned num_threads);
+
+    FlatHashMap<evmc::address, AccountId> account_ids_;
+    std::vector<AccountEntry> accounts_;  // by id
+    size_t number_of_accounts_{0};
+
+    // hash -> code
+    FlatHashMap<evmc::bytes32, Bytes> code_;
+
+    FlatHashMap<StorageKey, Storage> storage_;
 
     // block number -> hash -> header
     std::vector<std::unordered_map<evmc::bytes32, BlockHeader>> headers_;
@@ -107,10 +145,16 @@ class MemoryBuffer : public StateBuffer {
 
     std::vector<evmc::bytes32> canonical_hashes_;
 
-    std::unordered_map<uint64_t, AccountChanges> account_changes_;  // per block
-    std::unordered_map<uint64_t, StorageChanges> storage_changes_;  // per block
+    FlatHashMap<uint64_t, ChangeSet> changes_;  // per block
 
     uint64_t block_number_{0};
+
+    // Hashed account trie, brought up to date with the changed accounts by state_root_hash
+    mutable trie::CachedTrie account_trie_;
+    mutable std::vector<AccountId> changed_accounts_;  // accounts or storage changed
+
+    // Cleared by any change of accounts or storage
+    mutable std::optional<evmc::bytes32> state_root_;
 };
 
 }  // namespace silkworm
@@ -0,0 +1,78 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "memory_buffer.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+
+namespace silkworm {
+
+TEST_CASE("MemoryBuffer state changes") {
+    const evmc::address a{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const evmc::address b{0x8d12a197cb00d4747a1fe03395095ce2a5cc6819_address};
+    const evmc::bytes32 location{0x01_bytes32};
+    const evmc::bytes32 value1{0x0a_bytes32};
+    const evmc::bytes32 value2{0x0b_bytes32};
+
+    Account account_a;
+    account_a.balance = kEther;
+    Account contract_b;
+    contract_b.nonce = 1;
+    contract_b.incarnation = 1;
+
+    MemoryBuffer state;
+    state.begin_block(1);
+    state.update_account(a, std::nullopt, account_a);
+    state.update_account(b, std::nullopt, contract_b);
+    state.update_storage(b, 1, location, {}, value1);
+    const evmc::bytes32 root1{state.state_root_hash()};
+
+    CHECK(state.number_of_accounts() == 2);
+    CHECK(state.storage_size(b, 1) == 1);
+    CHECK(state.read_storage(b, 1, location) == value1);
+
+    state.begin_block(2);
+    Account updated_a{account_a};
+    updated_a.nonce = 1;
+    state.update_account(a, account_a, updated_a);
+    state.update_storage(b, 1, location, value1, value2);
+    state.update_account(b, contract_b, std::nullopt);
+    const evmc::bytes32 root2{state.state_root_hash()};
+
+    CHECK(root2 != root1);
+    CHECK(state.number_of_accounts() == 1);
+    CHECK(state.previous_incarnation(b) == 1);
+
+    // Same state built from scratch
+    MemoryBuffer expected;
+    expected.begin_block(1);
+    expected.update_account(a, std::nullopt, updated_a);
+    CHECK(to_hex(root2) == to_hex(expected.state_root_hash()));
+
+    state.unwind_state_changes(2);
+    CHECK(state.number_of_accounts() == 2);
+    CHECK(state.read_account(a)->nonce == 0);
+    CHECK(state.read_storage(b, 1, location) == value1);
+    CHECK(to_hex(state.state_root_hash()) == to_hex(root1));
+
+    state.unwind_state_changes(1);
+    CHECK(state.number_of_accounts() == 0);
+    CHECK(state.storage_size(b, 1) == 0);
+    CHECK(state.state_root_hash() == kEmptyRoot);
+}
+
+}  // namespace silkworm
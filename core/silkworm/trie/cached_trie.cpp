@@ -0,0 +1,169 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "cached_trie.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static bool key_less(const std::pair<evmc::bytes32, Bytes>& leaf, const evmc::bytes32& key) { return leaf.first < key; }
+
+void CachedTrie::put(const evmc::bytes32& key, Bytes value) {
+    changes_.emplace_back(key, std::move(value));
+    root_.reset();
+}
+
+void CachedTrie::erase(const evmc::bytes32& key) {
+    changes_.emplace_back(key, std::nullopt);
+    root_.reset();
+}
+
+evmc::bytes32 CachedTrie::root_hash(unsigned num_threads) {
+    if (root_) {
+        return *root_;
+    }
+
+    const std::vector<evmc::bytes32> changed_keys{apply_changes()};
+    if (leaves_.empty()) {
+        branches_.clear();
+        root_ = kEmptyRoot;
+    } else if (branches_.empty() || changed_keys.size() * 4 >= leaves_.size()) {
+        // Walking around the changes would save little
+        root_ = rebuild(num_threads);
+    } else {
+        root_ = update(changed_keys);
+    }
+    return *root_;
+}
+
+std::vector<evmc::bytes32> CachedTrie::apply_changes() {
+    // Sorted by key then position, leaving the values in place; only the last change of a key counts
+    std::vector<std::pair<evmc::bytes32, size_t>> order(changes_.size());
+    for (size_t i{0}; i < changes_.size(); ++i) {
+        order[i] = {changes_[i].first, i};
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<evmc::bytes32> keys;
+    std::vector<std::pair<evmc::bytes32, std::optional<Bytes>>*> last_changes;
+    for (size_t i{0}; i < order.size(); ++i) {
+        if (i + 1 == order.size() || order[i + 1].first != order[i].first) {
+            keys.push_back(order[i].first);
+            last_changes.push_back(&changes_[order[i].second]);
+        }
+    }
+
+    // Values of existing leaves are updated in place; insertions & erasures take a merge
+    bool reshape{false};
+    for (auto* change : last_changes) {
+        auto leaf{std::lower_bound(leaves_.begin(), leaves_.end(), change->first, key_less)};
+        const bool exists{leaf != leaves_.end() && leaf->first == change->first};
+        if (exists && change->second) {
+            leaf->second = std::move(*change->second);
+        } else if (exists || change->second) {
+            reshape = true;
+        }
+    }
+
+    if (reshape) {
+        Leaves merged;
+        merged.reserve(leaves_.size() + last_changes.size());
+        auto leaf{leaves_.begin()};
+        for (auto* change : last_changes) {
+            for (; leaf != leaves_.end() && leaf->first < change->first; ++leaf) {
+                merged.push_back(std::move(*leaf));
+            }
+            const bool exists{leaf != leaves_.end() && leaf->first == change->first};
+            if (exists) {
+                if (change->second) {
+                    merged.push_back(std::move(*leaf));  // already updated
+                }
+                ++leaf;
+            } else if (change->second) {
+                merged.emplace_back(change->first, std::move(*change->second));
+            }
+        }
+        std::move(leaf, leaves_.end(), std::back_inserter(merged));
+        leaves_.swap(merged);
+    }
+
+    changes_.clear();
+    return keys;
+}
+
+evmc::bytes32 CachedTrie::rebuild(unsigned num_threads) {
+    branches_.clear();
+    return parallel_root_hash(leaves_, num_threads, [this](ByteView path, ByteView node_ref) {
+        if (!path.empty() && node_ref.length() == kHashLength) {
+            branches_.emplace(path, to_bytes32(node_ref));
+        }
+    });
+}
+
+/*
+ * Same walk as over the intermediate hashes in the database:
+ * a recorded branch node is reused unless one of the changed keys lies beneath it,
+ * in which case it's dropped and the walk descends into it.
+ */
+evmc::bytes32 CachedTrie::update(const std::vector<evmc::bytes32>& changed_keys) {
+    std::vector<Bytes> changed_paths;
+    changed_paths.reserve(changed_keys.size());
+    for (const auto& key : changed_keys) {
+        changed_paths.push_back(unpack_nibbles(full_view(key)));
+    }
+
+    std::vector<std::pair<Bytes, evmc::bytes32>> new_branches;
+    HashBuilder hb;
+    hb.node_collector = [&new_branches](ByteView path, ByteView node_ref) {
+        if (!path.empty() && node_ref.length() == kHashLength) {
+            new_branches.emplace_back(path, to_bytes32(node_ref));
+        }
+    };
+
+    std::optional<Bytes> pos{Bytes{}};
+    while (pos) {
+        auto branch{branches_.lower_bound(*pos)};
+        while (branch != branches_.end() && is_prefix_of_any(changed_paths, branch->first)) {
+            branch = branches_.erase(branch);
+        }
+
+        // Leaves in [pos, branch)
+        auto leaf{std::lower_bound(leaves_.begin(), leaves_.end(), to_bytes32(seek_key(*pos)), key_less)};
+        for (; leaf != leaves_.end(); ++leaf) {
+            if (branch != branches_.end() && !key_precedes_path(full_view(leaf->first), branch->first)) {
+                break;
+            }
+            hb.add(full_view(leaf->first), leaf->second);
+        }
+
+        if (branch == branches_.end()) {
+            break;
+        }
+        hb.add_branch_node(branch->first, branch->second);
+        pos = next_path(branch->first);
+    }
+
+    const evmc::bytes32 root{hb.root_hash()};
+    for (auto& [path, hash] : new_branches) {
+        branches_[std::move(path)] = hash;
+    }
+    return root;
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,64 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_CACHED_TRIE_H_
+#define SILKWORM_TRIE_CACHED_TRIE_H_
+
+#include <map>
+#include <optional>
+#include <silkworm/common/base.hpp>
+#include <silkworm/trie/parallel_root.hpp>
+#include <vector>
+
+namespace silkworm::trie {
+
+// Trie held in memory together with the hashes of its branch nodes,
+// so that after a few changes the root is recalculated out of the unchanged subtries
+// rather than out of all the leaves.
+// This is the in-memory counterpart of the intermediate hashes kept in the database.
+class CachedTrie {
+  public:
+    // Keys are hashed keys; values are the RLP of the leaves.
+    // Changes are only applied by the next root_hash call.
+    void put(const evmc::bytes32& key, Bytes value);
+
+    void erase(const evmc::bytes32& key);
+
+    // A full rebuild, on the first call or after many changes, is spread over up to num_threads threads.
+    evmc::bytes32 root_hash(unsigned num_threads = 1);
+
+  private:
+    // Merges the pending changes into the leaves and returns the changed keys, sorted
+    std::vector<evmc::bytes32> apply_changes();
+
+    evmc::bytes32 rebuild(unsigned num_threads);
+
+    evmc::bytes32 update(const std::vector<evmc::bytes32>& changed_keys);
+
+    Leaves leaves_;  // sorted by key
+
+    // unpacked path -> hash of the branch node there
+    std::map<Bytes, evmc::bytes32> branches_;
+
+    // In order; std::nullopt for an erasure
+    std::vector<std::pair<evmc::bytes32, std::optional<Bytes>>> changes_;
+
+    std::optional<evmc::bytes32> root_;
+};
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_CACHED_TRIE_H_
@@ -0,0 +1,73 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "cached_trie.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <random>
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static evmc::bytes32 expected_root(const std::map<evmc::bytes32, Bytes>& leaves) {
+    HashBuilder hb;
+    for (const auto& [key, value] : leaves) {
+        hb.add(full_view(key), value);
+    }
+    return hb.root_hash();
+}
+
+TEST_CASE("CachedTrie") {
+    CachedTrie trie;
+    CHECK(trie.root_hash() == kEmptyRoot);
+
+    std::map<evmc::bytes32, Bytes> expected;
+    std::mt19937_64 rng{1};
+
+    // Keys sharing prefixes so that deep branch nodes get recorded, reused and dropped
+    auto random_key = [&rng]() {
+        evmc::bytes32 key{};
+        const uint64_t x{rng() % 5'000};
+        std::memcpy(key.bytes, &x, sizeof(x));
+        return to_bytes32(full_view(keccak256(full_view(key)).bytes));
+    };
+
+    for (size_t round{0}; round < 50; ++round) {
+        // A large first round, then a few changes per round
+        const size_t num_changes{round == 0 ? 3'000 : rng() % 50};
+        for (size_t i{0}; i < num_changes; ++i) {
+            const evmc::bytes32 key{random_key()};
+            if (rng() % 4 == 0) {
+                trie.erase(key);
+                expected.erase(key);
+            } else {
+                const Bytes value(1 + rng() % 40, static_cast<uint8_t>(i));
+                trie.put(key, value);
+                expected[key] = value;
+            }
+        }
+        REQUIRE(to_hex(trie.root_hash(/*num_threads=*/round % 3 + 1)) == to_hex(expected_root(expected)));
+    }
+
+    for (const auto& entry : std::map<evmc::bytes32, Bytes>{expected}) {
+        trie.erase(entry.first);
+    }
+    CHECK(trie.root_hash() == kEmptyRoot);
+}
+
+}  // namespace silkworm::trie
@@ -25,101 +25,187 @@
 
 namespace silkworm::trie {
 
-static Bytes unpack_nibbles(ByteView packed) {
-    Bytes out(2 * packed.length(), '\0');
+void unpack_nibbles(ByteView packed, Bytes& out) {
+    out.resize(2 * packed.length());
     for (size_t i{0}; i < packed.length(); ++i) {
         out[2 * i] = packed[i] >> 4;
         out[2 * i + 1] = packed[i] & 0xF;
     }
+}
+
+Bytes unpack_nibbles(ByteView packed) {
+    Bytes out;
+    unpack_nibbles(packed, out);
     return out;
 }
 
-static Bytes encode_path(ByteView path, bool terminating) {
-    Bytes res(path.length() / 2 + 1, '\0');
-    bool odd{path.length() % 2 != 0};
+Bytes seek_key(ByteView path) {
+    Bytes key(kHashLength, '\0');
+    for (size_t i{0}; i < path.length() && i < 2 * kHashLength; ++i) {
+        key[i / 2] |= i % 2 ? path[i] : path[i] << 4;
+    }
+    return key;
+}
 
-    if (!terminating && !odd) {
-        res[0] = 0x00;
-    } else if (!terminating && odd) {
-        res[0] = 0x10;
-    } else if (terminating && !odd) {
-        res[0] = 0x20;
-    } else if (terminating && odd) {
-        res[0] = 0x30;
+std::optional<Bytes> next_path(ByteView path) {
+    Bytes res{path};
+    while (!res.empty() && res.back() == 0xF) {
+        res.pop_back();
+    }
+    if (res.empty()) {
+        return std::nullopt;
     }
+    ++res.back();
+    return res;
+}
 
-    if (odd) {
-        res[0] |= path[0];
-        for (size_t i{1}; i < res.length(); ++i) {
-            res[i] = (path[2 * i - 1] << 4) + path[2 * i];
+bool key_precedes_path(ByteView key, ByteView path) {
+    for (size_t i{0}; i < path.length(); ++i) {
+        if (i == 2 * key.length()) {
+            return true;
         }
-    } else {
-        for (size_t i{1}; i < res.length(); ++i) {
-            res[i] = (path[2 * i - 2] << 4) + path[2 * i - 1];
+        uint8_t nibble = i % 2 ? key[i / 2] & 0xF : key[i / 2] >> 4;
+        if (nibble != path[i]) {
+            return nibble < path[i];
         }
     }
+    return false;
+}
 
+bool is_prefix_of_any(const std::vector<Bytes>& keys, ByteView path) {
+    auto it{std::lower_bound(keys.begin(), keys.end(), path)};
+    return it != keys.end() && has_prefix(*it, path);
+}
+
+// First byte of the hex-prefix encoding of a path
+static uint8_t path_prefix(ByteView path, bool terminating) {
+    uint8_t res{terminating ? uint8_t{0x20} : uint8_t{0x00}};
+    if (path.length() % 2 != 0) {
+        res |= 0x10 | path[0];
+    }
     return res;
 }
 
-// RLP of a leaf or extension node
-static Bytes short_node_rlp(ByteView encoded_path, ByteView payload) {
-    Bytes rlp{};
-    rlp::Header h;
-    h.list = true;
-    h.payload_length = rlp::length(encoded_path) + rlp::length(payload);
-    rlp::encode_header(rlp, h);
-    rlp::encode(rlp, encoded_path);
-    rlp::encode(rlp, payload);
-    return rlp;
+static size_t encoded_path_length(ByteView path) { return path.length() / 2 + 1; }
+
+static size_t encoded_path_rlp_length(ByteView path, bool terminating) {
+    const size_t len{encoded_path_length(path)};
+    if (len == 1 && path_prefix(path, terminating) < rlp::kEmptyStringCode) {
+        return 1;
+    }
+    return len + rlp::length_of_length(len);
 }
 
-static Bytes leaf_node_rlp(ByteView path, ByteView value) {
-    return short_node_rlp(encode_path(path, /*terminating=*/true), value);
+// Appends the RLP of the hex-prefix encoded path
+static void encode_path(Bytes& to, ByteView path, bool terminating) {
+    const size_t len{encoded_path_length(path)};
+    const uint8_t prefix{path_prefix(path, terminating)};
+    if (len != 1 || prefix >= rlp::kEmptyStringCode) {
+        rlp::Header h;
+        h.payload_length = len;
+        rlp::encode_header(to, h);
+    }
+    to.push_back(prefix);
+    for (size_t i{path.length() % 2}; i < path.length(); i += 2) {
+        to.push_back(static_cast<uint8_t>((path[i] << 4) + path[i + 1]));
+    }
 }
 
-static Bytes extension_node_rlp(ByteView path, ByteView child_ref) {
-    return short_node_rlp(encode_path(path, /*terminating=*/false), child_ref);
+void encode_short_node(Bytes& to, ByteView path, bool terminating, ByteView payload) {
+    to.clear();
+    rlp::Header h;
+    h.list = true;
+    h.payload_length = encoded_path_rlp_length(path, terminating) + rlp::length(payload);
+    rlp::encode_header(to, h);
+    encode_path(to, path, terminating);
+    rlp::encode(to, payload);
 }
 
-static ByteView node_ref(ByteView rlp) {
-    if (rlp.length() < kHashLength) {
-        return rlp;
+void HashBuilder::node_ref(NodeRef& ref, ByteView path) {
+    if (node_rlp_collector) {
+        node_rlp_collector(path, rlp_);
+    }
+
+    if (rlp_.length() < kHashLength) {
+        ref.length = static_cast<uint8_t>(rlp_.length());
+        std::memcpy(ref.bytes, rlp_.data(), rlp_.length());
+        return;
     }
 
-    thread_local ethash::hash256 hash;
-    hash = keccak256(rlp);
-    return {hash.bytes, kHashLength};
+    const ethash::hash256 hash{keccak256(rlp_)};
+    ref.length = kHashLength;
+    std::memcpy(ref.bytes, hash.bytes, kHashLength);
+}
+
+// Capacities fitting hashed (32 bytes) keys so that buffers don't need to grow once in use
+static constexpr size_t kMaxDepth{2 * kHashLength + 1};
+static constexpr size_t kMaxBranchRlpLength{3 + 16 * (kHashLength + 1) + 1};
+
+HashBuilder::HashBuilder() {
+    key_.reserve(2 * kHashLength);
+    next_key_.reserve(2 * kHashLength);
+    groups_.reserve(kMaxDepth);
+    stack_.reserve(kMaxDepth);
+    rlp_.reserve(kMaxBranchRlpLength);
 }
 
-HashBuilder::HashBuilder(ByteView key0, ByteView value0) : key_{unpack_nibbles(key0)}, value_{value0} {}
+HashBuilder::HashBuilder(ByteView key0, ByteView value0) : HashBuilder() {
+    unpack_nibbles(key0, key_);
+    value_.assign(value0.data(), value0.length());
+}
 
 void HashBuilder::add(ByteView packed, ByteView value) {
-    Bytes key{unpack_nibbles(packed)};
-    assert(key > key_);
-    gen_struct_step(key_, key, value_);
-    key_ = key;
-    value_ = value;
+    unpack_nibbles(packed, next_key_);
+    assert(next_key_ > key_);
+    if (!key_.empty()) {
+        gen_struct_step(key_, next_key_, value_, branch_node_);
+    }
+    key_.swap(next_key_);
+    value_.assign(value.data(), value.length());
+    branch_node_ = false;
+}
+
+void HashBuilder::add_branch_node(ByteView path, const evmc::bytes32& hash) {
+    assert(!path.empty() && path > key_);
+    if (!key_.empty()) {
+        gen_struct_step(key_, path, value_, branch_node_);
+    }
+    key_.assign(path.data(), path.length());
+    value_.assign(hash.bytes, kHashLength);
+    branch_node_ = true;
 }
 
 evmc::bytes32 HashBuilder::root_hash() {
-    gen_struct_step(key_, {}, value_);
+    if (key_.empty() && stack_.empty()) {
+        return kEmptyRoot;
+    }
+
+    gen_struct_step(key_, {}, value_, branch_node_);
     key_.clear();
     value_.clear();
+    branch_node_ = false;
 
-    Bytes& node_ref{stack_.back()};
+    const NodeRef& root{stack_.back()};
     evmc::bytes32 res{};
-    if (node_ref.length() == kHashLength) {
-        std::memcpy(res.bytes, node_ref.data(), kHashLength);
+    if (root.length == kHashLength) {
+        std::memcpy(res.bytes, root.bytes, kHashLength);
     } else {
-        ethash::hash256 hash{keccak256(node_ref)};
+        ethash::hash256 hash{keccak256(root.view())};
         std::memcpy(res.bytes, hash.bytes, kHashLength);
     }
     return res;
 }
 
+void HashBuilder::reset() {
+    key_.clear();
+    value_.clear();
+    branch_node_ = false;
+    groups_.clear();
+    stack_.clear();
+}
+
 // https://github.com/ledgerwatch/turbo-geth/blob/master/docs/programmers_guide/guide.md#generating-the-structural-information-from-the-sequence-of-keys
-void HashBuilder::gen_struct_step(ByteView curr, const ByteView succ, const ByteView value) {
+void HashBuilder::gen_struct_step(ByteView curr, const ByteView succ, const ByteView value, bool is_branch) {
     for (bool build_extensions{false};; build_extensions = true) {
         const bool prec_exists{!groups_.empty()};
         const size_t prec_len{groups_.empty() ? 0 : groups_.size() - 1};
@@ -140,11 +226,24 @@ void HashBuilder::gen_struct_step(ByteView curr, const ByteView succ, const Byte
             ++remainder_start;
         }
 
+        const ByteView short_node_path{curr.substr(0, remainder_start)};
         const ByteView short_node_key{curr.substr(remainder_start)};
         if (!build_extensions) {
-            stack_.emplace_back(node_ref(leaf_node_rlp(short_node_key, value)));
+            stack_.emplace_back();
+            if (!is_branch) {
+                encode_short_node(rlp_, short_node_key, /*terminating=*/true, value);
+                node_ref(stack_.back(), short_node_path);
+            } else {
+                stack_.back().length = kHashLength;
+                std::memcpy(stack_.back().bytes, value.data(), kHashLength);
+                if (!short_node_key.empty()) {
+                    encode_short_node(rlp_, short_node_key, /*terminating=*/false, stack_.back().view());
+                    node_ref(stack_.back(), short_node_path);
+                }
+            }
         } else if (!short_node_key.empty()) {
-            stack_.back() = node_ref(extension_node_rlp(short_node_key, stack_.back()));
+            encode_short_node(rlp_, short_node_key, /*terminating=*/false, stack_.back().view());
+            node_ref(stack_.back(), short_node_path);
         }
 
         // Check for the optional part
@@ -154,7 +253,7 @@ void HashBuilder::gen_struct_step(ByteView curr, const ByteView succ, const Byte
 
         // Close the immediately encompassing prefix group, if needed
         if (!succ.empty() || prec_exists) {
-            branch_ref(groups_[max_len]);
+            branch_ref(curr.substr(0, max_len), groups_[max_len]);
         }
 
         groups_.resize(max_len);
@@ -173,7 +272,7 @@ void HashBuilder::gen_struct_step(ByteView curr, const ByteView succ, const Byte
 }
 
 // Takes children from the stack and replaces them with branch node ref.
-void HashBuilder::branch_ref(uint16_t mask) {
+void HashBuilder::branch_ref(ByteView path, uint16_t mask) {
     const size_t first_child_idx{stack_.size() - popcount(mask)};
 
     rlp::Header h;
@@ -182,25 +281,29 @@ void HashBuilder::branch_ref(uint16_t mask) {
 
     for (size_t i{first_child_idx}, digit{0}; digit < 16; ++digit) {
         if (mask & (1u << digit)) {
-            h.payload_length += stack_[i++].length();
+            h.payload_length += stack_[i++].length;
         }
     }
 
-    Bytes rlp{};
-    rlp::encode_header(rlp, h);
+    rlp_.clear();
+    rlp::encode_header(rlp_, h);
 
     for (size_t i{first_child_idx}, digit{0}; digit < 16; ++digit) {
         if (mask & (1u << digit)) {
-            rlp::encode(rlp, stack_[i++]);
+            rlp::encode(rlp_, stack_[i++].view());
         } else {
-            rlp.push_back(rlp::kEmptyStringCode);
+            rlp_.push_back(rlp::kEmptyStringCode);
         }
     }
 
     // branch nodes with values are not supported
-    rlp.push_back(rlp::kEmptyStringCode);
+    rlp_.push_back(rlp::kEmptyStringCode);
 
     stack_.resize(first_child_idx + 1);
-    stack_.back() = node_ref(rlp);
+    node_ref(stack_.back(), path);
+
+    if (node_collector) {
+        node_collector(path, stack_.back().view());
+    }
 }
 }  // namespace silkworm::trie
@@ -17,6 +17,8 @@
 #ifndef SILKWORM_TRIE_HASH_BUILDER_H_
 #define SILKWORM_TRIE_HASH_BUILDER_H_
 
+#include <functional>
+#include <optional>
 #include <silkworm/common/base.hpp>
 #include <vector>
 
@@ -30,7 +32,9 @@ class HashBuilder {
     HashBuilder(const HashBuilder&) = delete;
     HashBuilder& operator=(const HashBuilder&) = delete;
 
-    // Must be constructed with the very first (lexicographically) key/value pair.
+    HashBuilder();
+
+    // Constructs with the very first (lexicographically) key/value pair.
     HashBuilder(ByteView key0, ByteView value0);
 
     // Entries must be added in the strictly increasing lexicographic order (by key).
@@ -39,20 +43,75 @@ class HashBuilder {
     // (e.g. keys "ab" & "ab05" are mutually exclusive).
     void add(ByteView key, ByteView value);
 
+    // Adds an already known branch node by its hash in place of the whole subtrie under the given path.
+    // The path is unpacked (one nibble per byte) and follows the same ordering rules as keys:
+    // none of the other entries may have the path as a prefix.
+    void add_branch_node(ByteView path, const evmc::bytes32& hash);
+
     // May only be called after all entries have been added.
+    // Returns kEmptyRoot if no entry has been added.
     evmc::bytes32 root_hash();
 
+    // Forgets all entries so that another trie may be built, keeping the memory allocated so far.
+    void reset();
+
+    // If set, gets called for every branch node built with its unpacked path and node reference
+    std::function<void(ByteView path, ByteView node_ref)> node_collector;
+
+    // If set, gets called for every node built (leaf, extension or branch) with its unpacked path and RLP.
+    // Nodes under branch nodes added with add_branch_node are never built.
+    std::function<void(ByteView path, ByteView rlp)> node_rlp_collector;
+
    private:
-    void gen_struct_step(ByteView curr, ByteView succ, ByteView value);
+    // Reference to a node: its hash or, if shorter than 32 bytes, its RLP
+    struct NodeRef {
+        uint8_t length{0};
+        uint8_t bytes[kHashLength];
 
-    void branch_ref(uint16_t mask);
+        ByteView view() const { return {bytes, length}; }
+    };
+
+    void gen_struct_step(ByteView curr, ByteView succ, ByteView value, bool is_branch);
+
+    void branch_ref(ByteView path, uint16_t mask);
+
+    // Sets the reference of the node encoded in rlp_, which lies at the given path
+    void node_ref(NodeRef& ref, ByteView path);
 
     Bytes key_;  // unpacked – one nibble per byte
     Bytes value_;
+    bool branch_node_{false};  // whether value_ is the hash of a branch node rather than a leaf value
 
     std::vector<uint16_t> groups_;
-    std::vector<Bytes> stack_;  // node references: hashes or embedded RLPs
+    std::vector<NodeRef> stack_;
+
+    // Scratch buffers reused across calls so that steady-state add() doesn't allocate
+    Bytes next_key_;
+    Bytes rlp_;
 };
+
+// Sets to the RLP of a leaf (terminating) or extension node with the given unpacked path.
+// The payload is the value of a leaf or the reference of the child of an extension.
+void encode_short_node(Bytes& to, ByteView path, bool terminating, ByteView payload);
+
+// Splits each byte into two nibbles
+Bytes unpack_nibbles(ByteView packed);
+
+// Same as above reusing the memory of out
+void unpack_nibbles(ByteView packed, Bytes& out);
+
+// Smallest 32 bytes key having the given (unpacked) path as prefix
+Bytes seek_key(ByteView path);
+
+// Smallest path greater than the given one and not having it as prefix; std::nullopt if there's none
+std::optional<Bytes> next_path(ByteView path);
+
+// Compares a (packed) key against an (unpacked) path nibble by nibble
+bool key_precedes_path(ByteView key, ByteView path);
+
+// Whether any of the (sorted, unpacked) keys has the given path as prefix
+bool is_prefix_of_any(const std::vector<Bytes>& keys, ByteView path);
+
 }  // namespace silkworm::trie
 
 #endif  // SILKWORM_TRIE_HASH_BUILDER_H_
@@ -18,8 +18,10 @@
 
 #include <algorithm>
 #include <catch2/catch.hpp>
+#include <cstring>
 #include <ethash/keccak.hpp>
 #include <iterator>
+#include <map>
 #include <silkworm/common/util.hpp>
 
 namespace silkworm::trie {
@@ -65,4 +67,97 @@ TEST_CASE("HashBuilder") {
     CHECK(to_hex(hb1.root_hash()) == to_hex(full_view(hash1.bytes)));
 }
 
+TEST_CASE("HashBuilder with no entries") {
+    HashBuilder hb;
+    CHECK(hb.root_hash() == kEmptyRoot);
+}
+
+TEST_CASE("HashBuilder with known branch nodes") {
+    std::vector<Bytes> keys{
+        *from_hex("1234000000000000000000000000000000000000000000000000000000000000"),
+        *from_hex("1235000000000000000000000000000000000000000000000000000000000000"),
+        *from_hex("1240000000000000000000000000000000000000000000000000000000000000"),
+        *from_hex("2000000000000000000000000000000000000000000000000000000000000000"),
+        *from_hex("2f00000000000000000000000000000000000000000000000000000000000000"),
+        *from_hex("5500000000000000000000000000000000000000000000000000000000000000"),
+    };
+    const Bytes value(32, 0xab);
+
+    std::vector<std::pair<Bytes, Bytes>> branches;
+    HashBuilder hb;
+    hb.node_collector = [&branches](ByteView path, ByteView node_ref) {
+        branches.emplace_back(path, node_ref);
+    };
+    for (const auto& key : keys) {
+        hb.add(key, value);
+    }
+    const evmc::bytes32 root{hb.root_hash()};
+
+    // Branch nodes at 0x123, 0x12, 0x2 and the root
+    REQUIRE(branches.size() == 4);
+    CHECK(branches[0].first == *from_hex("010203"));
+    CHECK(branches[1].first == *from_hex("0102"));
+    CHECK(branches[2].first == *from_hex("02"));
+    CHECK(branches[3].first.empty());
+    for (const auto& branch : branches) {
+        REQUIRE(branch.second.length() == kHashLength);
+    }
+
+    auto to_hash = [](ByteView node_ref) {
+        evmc::bytes32 hash;
+        std::memcpy(hash.bytes, node_ref.data(), kHashLength);
+        return hash;
+    };
+
+    // Replace the subtries at 0x12 (under an extension) and 0x2 by their branch hashes
+    HashBuilder hb1;
+    hb1.add_branch_node(branches[1].first, to_hash(branches[1].second));
+    hb1.add_branch_node(branches[2].first, to_hash(branches[2].second));
+    hb1.add(keys[5], value);
+    CHECK(to_hex(hb1.root_hash()) == to_hex(root));
+
+    // Mix leaves and a branch node at 0x123
+    HashBuilder hb2;
+    hb2.add_branch_node(branches[0].first, to_hash(branches[0].second));
+    for (size_t i{2}; i < keys.size(); ++i) {
+        hb2.add(keys[i], value);
+    }
+    CHECK(to_hex(hb2.root_hash()) == to_hex(root));
+}
+
+TEST_CASE("HashBuilder node RLP") {
+    const Bytes key0{*from_hex("1234000000000000000000000000000000000000000000000000000000000000")};
+    const Bytes key1{*from_hex("1235000000000000000000000000000000000000000000000000000000000000")};
+    const Bytes key2{*from_hex("5500000000000000000000000000000000000000000000000000000000000000")};
+    const Bytes value(32, 0xab);
+
+    std::map<Bytes, Bytes> nodes;
+    HashBuilder hb;
+    hb.node_rlp_collector = [&nodes](ByteView path, ByteView rlp) { CHECK(nodes.emplace(path, rlp).second); };
+    hb.add(key0, value);
+    hb.add(key1, value);
+    hb.add(key2, value);
+    const evmc::bytes32 root{hb.root_hash()};
+
+    // Root branch -> extension "23" -> branch at 0x123 -> leaves, plus the leaf at 0x5
+    std::vector<Bytes> paths{{}, *from_hex("01"), *from_hex("010203"), *from_hex("01020304"), *from_hex("01020305"),
+                             *from_hex("05")};
+    REQUIRE(nodes.size() == paths.size());
+    for (const auto& path : paths) {
+        REQUIRE(nodes.count(path));
+    }
+    CHECK(to_hex(full_view(keccak256(nodes[{}]).bytes)) == to_hex(root));
+
+    // Every node is referenced by hash from the node above it
+    auto referenced_by = [&nodes](const Bytes& child, const Bytes& parent) {
+        const ethash::hash256 hash{keccak256(nodes[child])};
+        return nodes[parent].find(full_view(hash.bytes)) != Bytes::npos;
+    };
+    CHECK(referenced_by(paths[1], paths[0]));
+    CHECK(referenced_by(paths[2], paths[1]));
+    CHECK(referenced_by(paths[3], paths[2]));
+    CHECK(referenced_by(paths[4], paths[2]));
+    CHECK(referenced_by(paths[5], paths[0]));
+}
+
 }  // namespace silkworm::trie
@@ -0,0 +1,89 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_root.hpp"
+
+#include <array>
+#include <silkworm/common/parallel_for_each.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static void add_leaves(HashBuilder& hb, const Leaves& leaves, size_t begin, size_t end) {
+    for (size_t i{begin}; i < end; ++i) {
+        hb.add(full_view(leaves[i].first), leaves[i].second);
+    }
+}
+
+evmc::bytes32 parallel_root_hash(const Leaves& leaves, unsigned num_threads,
+                                 const std::function<void(ByteView path, ByteView node_ref)>& node_collector) {
+    if (num_threads <= 1) {
+        HashBuilder hb;
+        hb.node_collector = node_collector;
+        add_leaves(hb, leaves, 0, leaves.size());
+        return hb.root_hash();
+    }
+
+    // Boundaries of the subtries under each first nibble
+    std::array<size_t, 17> bounds{};
+    for (uint8_t nibble{1}; nibble < 16; ++nibble) {
+        bounds[nibble] = std::lower_bound(leaves.begin() + bounds[nibble - 1], leaves.end(), nibble,
+                                          [](const auto& leaf, uint8_t n) { return (leaf.first.bytes[0] >> 4) < n; }) -
+                         leaves.begin();
+    }
+    bounds[16] = leaves.size();
+
+    // The branch nodes of each subtrie with at least two leaves : (path, node reference).
+    // HashBuilder reports branch nodes bottom up so the top one comes last;
+    // the others are only kept for the collector.
+    std::array<std::vector<std::pair<Bytes, Bytes>>, 16> branches;
+    parallel_for_each(16, num_threads, [&](size_t nibble) {
+        if (bounds[nibble + 1] - bounds[nibble] < 2) {
+            return;
+        }
+        HashBuilder hb;
+        hb.node_collector = [&branches, nibble, all{static_cast<bool>(node_collector)}](ByteView path,
+                                                                                        ByteView node_ref) {
+            if (!all) {
+                branches[nibble].clear();
+            }
+            branches[nibble].emplace_back(path, node_ref);
+        };
+        add_leaves(hb, leaves, bounds[nibble], bounds[nibble + 1]);
+        hb.root_hash();
+    });
+
+    HashBuilder hb;
+    hb.node_collector = node_collector;
+    for (size_t nibble{0}; nibble < 16; ++nibble) {
+        if (node_collector) {
+            for (const auto& [path, node_ref] : branches[nibble]) {
+                node_collector(path, node_ref);
+            }
+        }
+        const auto* top_branch{branches[nibble].empty() ? nullptr : &branches[nibble].back()};
+        if (top_branch && top_branch->second.length() == kHashLength) {
+            hb.add_branch_node(top_branch->first, to_bytes32(top_branch->second));
+        } else {
+            // Single leaf or tiny subtrie embedded into its parent
+            add_leaves(hb, leaves, bounds[nibble], bounds[nibble + 1]);
+        }
+    }
+    return hb.root_hash();
+}
+
+}  // namespace silkworm::trie
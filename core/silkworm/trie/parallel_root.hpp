@@ -0,0 +1,40 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_PARALLEL_ROOT_H_
+#define SILKWORM_TRIE_PARALLEL_ROOT_H_
+
+#include <functional>
+#include <silkworm/common/base.hpp>
+#include <utility>
+#include <vector>
+
+namespace silkworm::trie {
+
+// Trie leaves : hashed key -> value
+using Leaves = std::vector<std::pair<evmc::bytes32, Bytes>>;
+
+// Calculates the same root hash as HashBuilder fed with the given leaves
+// (which must be sorted by key with no duplicates), but builds the 16 subtries
+// under the first nibble concurrently on up to num_threads threads
+// before combining them into the root node.
+// If given, node_collector is called (from the calling thread only) like HashBuilder::node_collector.
+evmc::bytes32 parallel_root_hash(const Leaves& leaves, unsigned num_threads,
+                                 const std::function<void(ByteView path, ByteView node_ref)>& node_collector = {});
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_PARALLEL_ROOT_H_
@@ -0,0 +1,66 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "parallel_root.hpp"
+
+#include <catch2/catch.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static Leaves make_leaves(size_t n, uint8_t first_byte_mask = 0xFF) {
+    Leaves leaves;
+    for (size_t i{0}; i < n; ++i) {
+        Bytes preimage(8, '\0');
+        std::memcpy(&preimage[0], &i, sizeof(i));
+        evmc::bytes32 key{to_bytes32(full_view(keccak256(preimage).bytes))};
+        key.bytes[0] &= first_byte_mask;
+        Bytes value;
+        rlp::encode(value, static_cast<uint64_t>(i));
+        leaves.emplace_back(key, value);
+    }
+    std::sort(leaves.begin(), leaves.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    auto same_key = [](const auto& a, const auto& b) { return a.first == b.first; };
+    leaves.erase(std::unique(leaves.begin(), leaves.end(), same_key), leaves.end());
+    return leaves;
+}
+
+static evmc::bytes32 serial_root_hash(const Leaves& leaves) {
+    HashBuilder hb;
+    for (const auto& [key, value] : leaves) {
+        hb.add(full_view(key), value);
+    }
+    return hb.root_hash();
+}
+
+TEST_CASE("Parallel root hash") {
+    CHECK(parallel_root_hash({}, 4) == kEmptyRoot);
+
+    for (size_t n : {1, 2, 3, 17, 100, 5000}) {
+        Leaves leaves{make_leaves(n)};
+        const evmc::bytes32 expected{serial_root_hash(leaves)};
+        CHECK(to_hex(parallel_root_hash(leaves, 1)) == to_hex(expected));
+        CHECK(to_hex(parallel_root_hash(leaves, 4)) == to_hex(expected));
+    }
+
+    // All keys under the same first nibble
+    Leaves leaves{make_leaves(1000, 0x0F)};
+    CHECK(to_hex(parallel_root_hash(leaves, 4)) == to_hex(serial_root_hash(leaves)));
+}
+
+}  // namespace silkworm::trie
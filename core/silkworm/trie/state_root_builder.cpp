@@ -0,0 +1,60 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_root_builder.hpp"
+
+#include <cassert>
+#include <silkworm/common/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+
+namespace silkworm::trie {
+
+void StateRootBuilder::add_account(const evmc::bytes32& hashed_address, const Account& account) {
+    flush_account();
+    has_account_ = true;
+    hashed_address_ = hashed_address;
+    account_ = account;
+}
+
+void StateRootBuilder::add_storage(const evmc::bytes32& hashed_location, const evmc::bytes32& value) {
+    assert(has_account_ && !is_zero(value));
+    rlp_.clear();
+    rlp::encode(rlp_, zeroless_view(value));
+    storage_.add(full_view(hashed_location), rlp_);
+}
+
+void StateRootBuilder::flush_account() {
+    if (!has_account_) {
+        return;
+    }
+
+    account_.storage_root = storage_.root_hash();
+    storage_.reset();
+
+    rlp_.clear();
+    rlp::encode(rlp_, account_);
+    accounts_.add(full_view(hashed_address_), rlp_);
+
+    has_account_ = false;
+    ++num_accounts_;
+}
+
+evmc::bytes32 StateRootBuilder::root_hash() {
+    flush_account();
+    return accounts_.root_hash();
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,68 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_STATE_ROOT_BUILDER_H_
+#define SILKWORM_TRIE_STATE_ROOT_BUILDER_H_
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+#include <silkworm/types/account.hpp>
+
+namespace silkworm::trie {
+
+// Calculates the state root out of the hashed state streamed in a single pass, in key order:
+// each account followed by its storage slots, then the next account and so on
+// (e.g. a scan of kCurrentState or entries sorted by the ETL collector).
+// Only the current path of the account trie and of one storage trie are held in memory,
+// whatever the size of the state.
+class StateRootBuilder {
+  public:
+    StateRootBuilder(const StateRootBuilder&) = delete;
+    StateRootBuilder& operator=(const StateRootBuilder&) = delete;
+
+    StateRootBuilder() = default;
+
+    // Accounts must be added in strictly increasing order of hashed address.
+    // The storage root of the account is ignored: it's calculated out of the slots added next.
+    void add_account(const evmc::bytes32& hashed_address, const Account& account);
+
+    // Adds a non-zero slot to the storage of the account added last.
+    // Slots of an account must be added in strictly increasing order of hashed location.
+    void add_storage(const evmc::bytes32& hashed_location, const evmc::bytes32& value);
+
+    // May only be called after all accounts and slots have been added.
+    evmc::bytes32 root_hash();
+
+    uint64_t num_accounts() const { return num_accounts_; }
+
+  private:
+    // Adds the pending account to the account trie, now that all its slots are known
+    void flush_account();
+
+    HashBuilder accounts_;
+    HashBuilder storage_;
+
+    bool has_account_{false};
+    evmc::bytes32 hashed_address_{};
+    Account account_;
+    uint64_t num_accounts_{0};
+
+    Bytes rlp_;
+};
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_STATE_ROOT_BUILDER_H_
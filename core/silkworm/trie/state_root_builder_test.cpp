@@ -0,0 +1,80 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_root_builder.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <map>
+#include <silkworm/common/util.hpp>
+#include <silkworm/state/memory_buffer.hpp>
+
+namespace silkworm::trie {
+
+static evmc::bytes32 hash_of(ByteView preimage) { return to_bytes32(full_view(keccak256(preimage).bytes)); }
+
+TEST_CASE("StateRootBuilder") {
+    SECTION("Empty state") {
+        StateRootBuilder builder;
+        CHECK(builder.root_hash() == kEmptyRoot);
+    }
+
+    SECTION("Same root as MemoryBuffer") {
+        constexpr uint64_t kNumAccounts{1000};
+        constexpr uint64_t kIncarnation{1};
+
+        MemoryBuffer state;
+
+        // Hashed state, sorted : hashed address -> (account, hashed location -> value)
+        std::map<evmc::bytes32, std::pair<Account, std::map<evmc::bytes32, evmc::bytes32>>> hashed_state;
+
+        for (uint64_t i{0}; i < kNumAccounts; ++i) {
+            evmc::address address{};
+            std::memcpy(&address.bytes[12], &i, sizeof(i));
+            Account account;
+            account.nonce = i;
+            account.balance = i * kEther;
+            auto& [hashed_account, hashed_storage]{hashed_state[hash_of(full_view(address))]};
+
+            // Every 10th account is a contract with some storage
+            if (i % 10 == 0) {
+                account.incarnation = kIncarnation;
+                for (uint64_t j{0}; j < i / 10 + 1; ++j) {
+                    evmc::bytes32 location{};
+                    std::memcpy(&location.bytes[24], &j, sizeof(j));
+                    evmc::bytes32 value{};
+                    value.bytes[31] = static_cast<uint8_t>(j + 1);
+                    state.update_storage(address, kIncarnation, location, {}, value);
+                    hashed_storage[hash_of(full_view(location))] = value;
+                }
+            }
+            state.update_account(address, std::nullopt, account);
+            hashed_account = account;
+        }
+
+        StateRootBuilder builder;
+        for (const auto& [hashed_address, entry] : hashed_state) {
+            builder.add_account(hashed_address, entry.first);
+            for (const auto& [hashed_location, value] : entry.second) {
+                builder.add_storage(hashed_location, value);
+            }
+        }
+        CHECK(to_hex(builder.root_hash()) == to_hex(state.state_root_hash()));
+        CHECK(builder.num_accounts() == kNumAccounts);
+    }
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,225 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "vector_root.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <ethash/keccak.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
+
+namespace silkworm::trie {
+
+namespace {
+
+    // Unpacked RLP of an index : 0x80 for 0, the index itself up to 0x7f, then 0x80 + length & big endian bytes
+    struct IndexKey {
+        uint8_t nibbles[2 * (1 + sizeof(uint64_t))];
+        uint8_t length{0};
+
+        ByteView view() const { return {nibbles, length}; }
+    };
+
+    IndexKey index_key(uint64_t index) {
+        uint8_t bytes[1 + sizeof(uint64_t)];
+        size_t len{0};
+        if (index == 0) {
+            bytes[len++] = rlp::kEmptyStringCode;
+        } else if (index < rlp::kEmptyStringCode) {
+            bytes[len++] = static_cast<uint8_t>(index);
+        } else {
+            size_t be_len{0};
+            for (uint64_t x{index}; x; x >>= 8) {
+                ++be_len;
+            }
+            bytes[len++] = static_cast<uint8_t>(rlp::kEmptyStringCode + be_len);
+            for (size_t i{be_len}; i > 0; --i) {
+                bytes[len++] = static_cast<uint8_t>(index >> (8 * (i - 1)));
+            }
+        }
+
+        IndexKey key;
+        for (size_t i{0}; i < len; ++i) {
+            key.nibbles[2 * i] = bytes[i] >> 4;
+            key.nibbles[2 * i + 1] = bytes[i] & 0xF;
+        }
+        key.length = static_cast<uint8_t>(2 * len);
+        return key;
+    }
+
+    // Reference to a node: its hash or, if shorter than 32 bytes, its RLP
+    struct NodeRef {
+        uint8_t length{0};
+        uint8_t bytes[kHashLength];
+
+        ByteView view() const { return {bytes, length}; }
+    };
+
+    void set_ref(NodeRef& ref, ByteView rlp, const ethash::hash256* hash = nullptr) {
+        if (rlp.length() < kHashLength) {
+            ref.length = static_cast<uint8_t>(rlp.length());
+            std::memcpy(ref.bytes, rlp.data(), rlp.length());
+            return;
+        }
+        const ethash::hash256 h{hash ? *hash : keccak256(rlp)};
+        ref.length = kHashLength;
+        std::memcpy(ref.bytes, h.bytes, kHashLength);
+    }
+
+    /*
+     * Builds the trie top-down out of the keys in trie order (see adjust_index_for_rlp):
+     * as no key is a prefix of another, every node is either a leaf, an extension over the common prefix
+     * of its keys, or a branch with one contiguous run of keys per child nibble.
+     * Leaves under a same branch are hashed together.
+     */
+    class OrderedListTrie {
+      public:
+        OrderedListTrie(ByteView values_rlp, const std::vector<size_t>& ends) : values_{values_rlp}, ends_{ends} {
+            const size_t n{ends.size()};
+            keys_.reserve(n);
+            indices_.reserve(n);
+            for (size_t j{0}; j < n; ++j) {
+                const size_t index{adjust_index_for_rlp(j, n)};
+                keys_.push_back(index_key(index));
+                indices_.push_back(index);
+            }
+        }
+
+        evmc::bytes32 root_hash() {
+            NodeRef root;
+            node(0, keys_.size(), 0, root);
+            if (root.length == kHashLength) {
+                return to_bytes32(root.view());
+            }
+            return to_bytes32(full_view(keccak256(root.view()).bytes));
+        }
+
+      private:
+        ByteView value(size_t j) const {
+            const size_t index{indices_[j]};
+            const size_t begin{index ? ends_[index - 1] : 0};
+            return values_.substr(begin, ends_[index] - begin);
+        }
+
+        void leaf_rlp(Bytes& to, size_t j, size_t depth) const {
+            encode_short_node(to, keys_[j].view().substr(depth), /*terminating=*/true, value(j));
+        }
+
+        // Node over keys [lo, hi) sharing their first depth nibbles
+        void node(size_t lo, size_t hi, size_t depth, NodeRef& ref) {
+            if (hi - lo == 1) {
+                leaf_rlp(rlp_, lo, depth);
+                set_ref(ref, rlp_);
+                return;
+            }
+
+            const ByteView first{keys_[lo].view()};
+            const size_t common{depth + prefix_length(first.substr(depth), keys_[hi - 1].view().substr(depth))};
+            if (common == depth) {
+                branch(lo, hi, depth, ref);
+                return;
+            }
+
+            NodeRef child;
+            branch(lo, hi, common, child);
+            encode_short_node(rlp_, first.substr(depth, common - depth), /*terminating=*/false, child.view());
+            set_ref(ref, rlp_);
+        }
+
+        void branch(size_t lo, size_t hi, size_t depth, NodeRef& ref) {
+            // Runs of keys per nibble
+            std::array<std::pair<size_t, size_t>, 16> runs{};
+            for (size_t j{lo}; j < hi;) {
+                const uint8_t nibble{keys_[j].nibbles[depth]};
+                size_t end{j + 1};
+                while (end < hi && keys_[end].nibbles[depth] == nibble) {
+                    ++end;
+                }
+                runs[nibble] = {j, end};
+                j = end;
+            }
+
+            // Single keys become leaves, hashed all at once; larger runs become subtries
+            std::array<NodeRef, 16> children;
+            std::array<ByteView, 16> leaves;
+            std::array<uint8_t, 16> leaf_nibbles;
+            size_t num_leaves{0};
+            for (uint8_t nibble{0}; nibble < 16; ++nibble) {
+                const auto [begin, end]{runs[nibble]};
+                if (end - begin == 1) {
+                    leaf_rlp(leaf_rlp_[num_leaves], begin, depth + 1);
+                    leaves[num_leaves] = leaf_rlp_[num_leaves];
+                    leaf_nibbles[num_leaves++] = nibble;
+                }
+            }
+            std::array<ethash::hash256, 16> hashes;
+            crypto::keccak256_batch({hashes.data(), num_leaves}, {leaves.data(), num_leaves});
+            for (size_t i{0}; i < num_leaves; ++i) {
+                set_ref(children[leaf_nibbles[i]], leaves[i], &hashes[i]);
+            }
+            for (uint8_t nibble{0}; nibble < 16; ++nibble) {
+                const auto [begin, end]{runs[nibble]};
+                if (end - begin > 1) {
+                    node(begin, end, depth + 1, children[nibble]);
+                }
+            }
+
+            // Same encoding as HashBuilder::branch_ref
+            rlp::Header h;
+            h.list = true;
+            h.payload_length = 17;
+            for (uint8_t nibble{0}; nibble < 16; ++nibble) {
+                if (runs[nibble].second > runs[nibble].first) {
+                    h.payload_length += children[nibble].length;
+                }
+            }
+            rlp_.clear();
+            rlp::encode_header(rlp_, h);
+            for (uint8_t nibble{0}; nibble < 16; ++nibble) {
+                if (runs[nibble].second > runs[nibble].first) {
+                    rlp::encode(rlp_, children[nibble].view());
+                } else {
+                    rlp_.push_back(rlp::kEmptyStringCode);
+                }
+            }
+            rlp_.push_back(rlp::kEmptyStringCode);  // no value
+            set_ref(ref, rlp_);
+        }
+
+        ByteView values_;
+        const std::vector<size_t>& ends_;
+        std::vector<IndexKey> keys_;  // in trie order
+        std::vector<size_t> indices_;
+
+        // Scratch buffers : a node is encoded only once all its children are done with theirs
+        Bytes rlp_;
+        std::array<Bytes, 16> leaf_rlp_;
+    };
+
+}  // namespace
+
+evmc::bytes32 ordered_list_root_hash(ByteView values_rlp, const std::vector<size_t>& ends) {
+    if (ends.empty()) {
+        return kEmptyRoot;
+    }
+    assert(ends.back() == values_rlp.length());
+    OrderedListTrie trie{values_rlp, ends};
+    return trie.root_hash();
+}
+
+}  // namespace silkworm::trie
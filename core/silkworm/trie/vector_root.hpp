@@ -19,6 +19,7 @@
 
 #include <silkworm/rlp/encode.hpp>
 #include <silkworm/trie/hash_builder.hpp>
+#include <vector>
 
 namespace silkworm::trie {
 
@@ -34,10 +35,28 @@ inline size_t adjust_index_for_rlp(size_t i, size_t len) {
     }
 }
 
+// Trie root hash of an ordered list of items given by their RLP :
+// values_rlp is the concatenation of all items and ends[i] is the offset right past the i-th one.
+// Keys being dense RLP-encoded indices, the trie is built top-down in one pass with no sorting
+// and without going through HashBuilder.
+evmc::bytes32 ordered_list_root_hash(ByteView values_rlp, const std::vector<size_t>& ends);
+
 // Trie root hash of RLP-encoded values, the keys are RLP-encoded integers.
 // See Section 4.3.2. "Holistic Validity" of the Yellow Paper.
 template <class T>
 evmc::bytes32 root_hash(const std::vector<T>& v) {
+    Bytes values_rlp{};
+    std::vector<size_t> ends(v.size());
+    for (size_t i{0}; i < v.size(); ++i) {
+        rlp::encode(values_rlp, v[i]);
+        ends[i] = values_rlp.length();
+    }
+    return ordered_list_root_hash(values_rlp, ends);
+}
+
+// Same as root_hash, through the generic HashBuilder fed with keys in lexicographic order
+template <class T>
+evmc::bytes32 generic_root_hash(const std::vector<T>& v) {
     if (v.empty()) {
         return kEmptyRoot;
     }
@@ -43,5 +43,19 @@ TEST_CASE("Hardcoded root hash") {
         r.bloom = logs_bloom(r.logs);
     }
     CHECK(to_hex(root_hash(receipts)) == "7ea023138ee7d80db04eeec9cf436dc35806b00cc5fe8e5f611fb7cf1b35b177");
+    CHECK(to_hex(generic_root_hash(receipts)) == "7ea023138ee7d80db04eeec9cf436dc35806b00cc5fe8e5f611fb7cf1b35b177");
+}
+
+TEST_CASE("Ordered list root hash") {
+    // Short values make leaves embedded in their parent, long ones have them referenced by hash
+    for (size_t value_length : {1, 40}) {
+        for (size_t n : {1, 2, 3, 15, 16, 17, 127, 128, 129, 255, 256, 257, 1000, 70'000}) {
+            std::vector<Bytes> values(n);
+            for (size_t i{0}; i < n; ++i) {
+                values[i] = Bytes(value_length, static_cast<uint8_t>(i * 7));
+            }
+            CHECK(to_hex(root_hash(values)) == to_hex(generic_root_hash(values)));
+        }
+    }
 }
 }  // namespace silkworm::trie
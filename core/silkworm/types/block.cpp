@@ -16,14 +16,15 @@
 
 #include "block.hpp"
 
+#include <cassert>
 #include <cstring>
 #include <silkworm/rlp/encode.hpp>
 
 namespace silkworm {
 
-evmc::bytes32 BlockHeader::hash() const {
+evmc::bytes32 BlockHeader::hash(bool for_sealing) const {
     Bytes rlp;
-    rlp::encode(rlp, *this);
+    rlp::encode(rlp, *this, for_sealing);
     ethash::hash256 ethash_hash{keccak256(rlp)};
     evmc::bytes32 hash;
     std::memcpy(hash.bytes, ethash_hash.bytes, kHashLength);
@@ -43,24 +44,22 @@ bool operator==(const BlockBody& a, const BlockBody& b) {
     return a.transactions == b.transactions && a.ommers == b.ommers;
 }
 
-void Block::recover_senders(const ChainConfig& config) {
+void Block::recover_senders(const ChainConfig& config, SenderCache* sender_cache) {
     uint64_t block_number{header.number};
     bool homestead{config.has_homestead(block_number)};
     bool spurious_dragon{config.has_spurious_dragon(block_number)};
 
-    for (Transaction& txn : transactions) {
-        if (spurious_dragon) {
-            txn.recover_sender(homestead, config.chain_id);
-        } else {
-            txn.recover_sender(homestead, std::nullopt);
-        }
+    if (spurious_dragon) {
+        silkworm::recover_senders(transactions, homestead, config.chain_id, sender_cache);
+    } else {
+        silkworm::recover_senders(transactions, homestead, std::nullopt, sender_cache);
     }
 }
 
 namespace rlp {
 
-    static Header rlp_header(const BlockHeader& header) {
-        Header rlp_head{true, 6 * (kHashLength + 1)};
+    static Header rlp_header(const BlockHeader& header, bool for_sealing) {
+        Header rlp_head{true, 5 * (kHashLength + 1)};
         rlp_head.payload_length += kAddressLength + 1;  // beneficiary
         rlp_head.payload_length += kBloomByteLength + length_of_length(kBloomByteLength);
         rlp_head.payload_length += length(header.difficulty);
@@ -69,32 +68,54 @@ namespace rlp {
         rlp_head.payload_length += length(header.gas_used);
         rlp_head.payload_length += length(header.timestamp);
         rlp_head.payload_length += length(header.extra_data());
-        rlp_head.payload_length += 8 + 1;  // nonce
+        if (!for_sealing) {
+            rlp_head.payload_length += kHashLength + 1;  // mix_hash
+            rlp_head.payload_length += 8 + 1;            // nonce
+        }
         return rlp_head;
     }
 
     size_t length(const BlockHeader& header) {
-        Header rlp_head{rlp_header(header)};
+        Header rlp_head{rlp_header(header, /*for_sealing=*/false)};
         return length_of_length(rlp_head.payload_length) + rlp_head.payload_length;
     }
 
-    void encode(Bytes& to, const BlockHeader& header) {
-        encode_header(to, rlp_header(header));
-        encode(to, header.parent_hash.bytes);
-        encode(to, header.ommers_hash.bytes);
-        encode(to, header.beneficiary.bytes);
-        encode(to, header.state_root.bytes);
-        encode(to, header.transactions_root.bytes);
-        encode(to, header.receipts_root.bytes);
-        encode(to, full_view(header.logs_bloom));
-        encode(to, header.difficulty);
-        encode(to, header.number);
-        encode(to, header.gas_limit);
-        encode(to, header.gas_used);
-        encode(to, header.timestamp);
+    // Payload, back to front
+    static void encode_fields(ReverseEncoder& to, const BlockHeader& header, bool for_sealing) noexcept {
+        if (!for_sealing) {
+            encode(to, header.nonce);
+            encode(to, header.mix_hash.bytes);
+        }
         encode(to, header.extra_data());
-        encode(to, header.mix_hash.bytes);
-        encode(to, header.nonce);
+        encode(to, header.timestamp);
+        encode(to, header.gas_used);
+        encode(to, header.gas_limit);
+        encode(to, header.number);
+        encode(to, header.difficulty);
+        encode(to, full_view(header.logs_bloom));
+        encode(to, header.receipts_root.bytes);
+        encode(to, header.transactions_root.bytes);
+        encode(to, header.state_root.bytes);
+        encode(to, header.beneficiary.bytes);
+        encode(to, header.ommers_hash.bytes);
+        encode(to, header.parent_hash.bytes);
+    }
+
+    void encode(Bytes& to, const BlockHeader& header, bool for_sealing) {
+        const Header rlp_head{rlp_header(header, for_sealing)};
+        const size_t old_length{to.length()};
+        ReverseEncoder encoder{to, length_of_length(rlp_head.payload_length) + rlp_head.payload_length};
+        encode_fields(encoder, header, for_sealing);
+        encoder.prepend_header(rlp_head);
+        assert(encoder.position() == to.data() + old_length);
+    }
+
+    void encode(Bytes& to, const BlockHeader& header) { encode(to, header, /*for_sealing=*/false); }
+
+    void encode(ReverseEncoder& to, const BlockHeader& header) noexcept {
+        const uint8_t* payload_end{to.position()};
+        encode_fields(to, header, /*for_sealing=*/false);
+        to.prepend_list_header(payload_end);
     }
 
     template <>
@@ -169,13 +190,23 @@ namespace rlp {
         return from.length() == leftover ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
     }
 
+    size_t length(const BlockBody& block_body) {
+        const size_t payload_length{length(block_body.transactions) + length(block_body.ommers)};
+        return length_of_length(payload_length) + payload_length;
+    }
+
     void encode(Bytes& to, const BlockBody& block_body) {
-        Header rlp_head{true, 0};
-        rlp_head.payload_length += length(block_body.transactions);
-        rlp_head.payload_length += length(block_body.ommers);
-        encode_header(to, rlp_head);
-        encode(to, block_body.transactions);
+        const size_t old_length{to.length()};
+        ReverseEncoder encoder{to, length(block_body)};
+        encode(encoder, block_body);
+        assert(encoder.position() == to.data() + old_length);
+    }
+
+    void encode(ReverseEncoder& to, const BlockBody& block_body) noexcept {
+        const uint8_t* payload_end{to.position()};
         encode(to, block_body.ommers);
+        encode(to, block_body.transactions);
+        to.prepend_list_header(payload_end);
     }
 
     template <>
@@ -199,6 +230,46 @@ namespace rlp {
         return from.length() == leftover ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
     }
 
+    template <>
+    DecodingResult decode(ByteView& from, BlockBodyView& to) noexcept {
+        auto [rlp_head, err]{decode_header(from)};
+        if (err != DecodingResult::kOk) {
+            return err;
+        }
+        if (!rlp_head.list) {
+            return DecodingResult::kUnexpectedString;
+        }
+        uint64_t leftover{from.length() - rlp_head.payload_length};
+
+        if (DecodingResult err{decode_vector(from, to.transactions)}; err != DecodingResult::kOk) {
+            return err;
+        }
+
+        to.ommers = from;
+        auto [ommers_head, err2]{decode_header(from)};
+        if (err2 != DecodingResult::kOk) {
+            return err2;
+        }
+        if (!ommers_head.list) {
+            return DecodingResult::kUnexpectedString;
+        }
+        ByteView ommers_payload{from.substr(0, ommers_head.payload_length)};
+        while (!ommers_payload.empty()) {
+            auto [ommer_head, err3]{decode_header(ommers_payload)};
+            if (err3 != DecodingResult::kOk) {
+                return err3;
+            }
+            if (!ommer_head.list) {
+                return DecodingResult::kUnexpectedString;
+            }
+            ommers_payload.remove_prefix(ommer_head.payload_length);
+        }
+        from.remove_prefix(ommers_head.payload_length);
+        to.ommers = to.ommers.substr(0, to.ommers.length() - from.length());
+
+        return from.length() == leftover ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
+    }
+
     template <>
     DecodingResult decode(ByteView& from, Block& to) noexcept {
         auto [rlp_head, err]{decode_header(from)};
@@ -31,6 +31,8 @@
 
 namespace silkworm {
 
+class SenderCache;
+
 struct BlockHeader {
     evmc::bytes32 parent_hash{};
     evmc::bytes32 ommers_hash{};
@@ -50,7 +52,8 @@ struct BlockHeader {
     evmc::bytes32 mix_hash{};
     std::array<uint8_t, 8> nonce{};
 
-    evmc::bytes32 hash() const;
+    // for_sealing: without mix_hash & nonce, i.e. the hash that the proof of work seals
+    evmc::bytes32 hash(bool for_sealing = false) const;
 
   private:
     friend rlp::DecodingResult rlp::decode<BlockHeader>(ByteView& from, BlockHeader& to) noexcept;
@@ -72,10 +75,18 @@ bool operator==(const BlockBody& a, const BlockBody& b);
 
 inline bool operator!=(const BlockBody& a, const BlockBody& b) { return !(a == b); }
 
+// Read-only view of an RLP-encoded block body; see TransactionView.
+// Ommer headers are only checked to be lists: decode ommers when they are needed.
+struct BlockBodyView {
+    std::vector<TransactionView> transactions;
+    ByteView ommers;  // encoded list of ommer headers, whose keccak is the ommers hash
+};
+
 struct Block : public BlockBody {
     BlockHeader header;
 
-    void recover_senders(const ChainConfig& config);
+    // See silkworm::recover_senders
+    void recover_senders(const ChainConfig& config, SenderCache* sender_cache = nullptr);
 };
 
 struct BlockWithHash {
@@ -84,9 +95,14 @@ struct BlockWithHash {
 };
 
 namespace rlp {
+    void encode(Bytes& to, const BlockHeader& header, bool for_sealing);
+
     template <>
     DecodingResult decode(ByteView& from, BlockBody& to) noexcept;
 
+    template <>
+    DecodingResult decode(ByteView& from, BlockBodyView& to) noexcept;
+
     template <>
     DecodingResult decode(ByteView& from, BlockHeader& to) noexcept;
 
@@ -110,6 +110,21 @@ TEST_CASE("BlockBody RLP 2") {
 
     CHECK(view.empty());
     CHECK(decoded == body);
+
+    view = rlp;
+    BlockBodyView body_view{};
+    REQUIRE(rlp::decode(view, body_view) == rlp::DecodingResult::kOk);
+    CHECK(view.empty());
+    REQUIRE(body_view.transactions.size() == 2);
+    CHECK(body_view.transactions[0].materialize() == body.transactions[0]);
+    CHECK(body_view.transactions[1].materialize() == body.transactions[1]);
+
+    Bytes ommers_rlp{};
+    rlp::encode(ommers_rlp, body.ommers);
+    CHECK(body_view.ommers == ommers_rlp);
+    std::vector<BlockHeader> ommers;
+    REQUIRE(rlp::decode_vector(body_view.ommers, ommers) == rlp::DecodingResult::kOk);
+    CHECK(ommers == body.ommers);
 }
 
 TEST_CASE("Invlaid Block RLP") {
@@ -16,14 +16,13 @@
 
 #include "bloom.hpp"
 
-#include <ethash/keccak.hpp>
 #include <silkworm/common/util.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
 
 namespace silkworm {
 
 // See Section 4.3.1 "Transaction Receipt" of the Yellow Paper
-static void m3_2048(Bloom& bloom, ByteView x) {
-    ethash::hash256 hash{keccak256(x)};
+static void m3_2048(Bloom& bloom, const ethash::hash256& hash) {
     for (unsigned i{0}; i < 6; i += 2) {
         unsigned bit{(hash.bytes[i + 1] + (hash.bytes[i] << 8)) & 0x7FFu};
         bloom[kBloomByteLength - 1 - bit / 8] |= 1 << (bit % 8);
@@ -32,12 +31,33 @@ static void m3_2048(Bloom& bloom, ByteView x) {
 
 Bloom logs_bloom(const std::vector<Log>& logs) {
     Bloom bloom{};  // zero initialization
+
+    // Addresses & topics are hashed in batches
+    constexpr size_t kBatchSize{16};
+    ByteView inputs[kBatchSize];
+    ethash::hash256 hashes[kBatchSize];
+    size_t n{0};
+    const auto flush{[&]() {
+        crypto::keccak256_batch({hashes, n}, {inputs, n});
+        for (size_t i{0}; i < n; ++i) {
+            m3_2048(bloom, hashes[i]);
+        }
+        n = 0;
+    }};
+
     for (const Log& log : logs) {
-        m3_2048(bloom, full_view(log.address));
+        inputs[n++] = full_view(log.address);
         for (const auto& topic : log.topics) {
-            m3_2048(bloom, full_view(topic));
+            if (n == kBatchSize) {
+                flush();
+            }
+            inputs[n++] = full_view(topic);
+        }
+        if (n == kBatchSize) {
+            flush();
         }
     }
+    flush();
     return bloom;
 }
 }  // namespace silkworm
@@ -16,6 +16,7 @@
 
 #include "log.hpp"
 
+#include <cassert>
 #include <silkworm/common/util.hpp>
 #include <silkworm/rlp/encode.hpp>
 
@@ -36,10 +37,18 @@ size_t length(const Log& l) {
 }
 
 void encode(Bytes& to, const Log& l) {
-    encode_header(to, header(l));
-    encode(to, full_view(l.address));
-    encode(to, l.topics);
+    const size_t old_length{to.length()};
+    ReverseEncoder encoder{to, length(l)};
+    encode(encoder, l);
+    assert(encoder.position() == to.data() + old_length);
+}
+
+void encode(ReverseEncoder& to, const Log& l) noexcept {
+    const uint8_t* payload_end{to.position()};
     encode(to, l.data);
+    encode(to, l.topics);
+    encode(to, full_view(l.address));
+    to.prepend_list_header(payload_end);
 }
 
 }  // namespace silkworm::rlp
@@ -16,6 +16,7 @@
 
 #include "receipt.hpp"
 
+#include <cassert>
 #include <silkworm/common/util.hpp>
 #include <silkworm/rlp/encode.hpp>
 
@@ -31,12 +32,25 @@ static Header header(const Receipt& r) {
     return h;
 }
 
+size_t length(const Receipt& r) {
+    Header h{header(r)};
+    return length_of_length(h.payload_length) + h.payload_length;
+}
+
 void encode(Bytes& to, const Receipt& r) {
-    encode_header(to, header(r));
-    encode(to, r.success);
-    encode(to, r.cumulative_gas_used);
-    encode(to, full_view(r.bloom));
+    const size_t old_length{to.length()};
+    ReverseEncoder encoder{to, length(r)};
+    encode(encoder, r);
+    assert(encoder.position() == to.data() + old_length);
+}
+
+void encode(ReverseEncoder& to, const Receipt& r) noexcept {
+    const uint8_t* payload_end{to.position()};
     encode(to, r.logs);
+    encode(to, full_view(r.bloom));
+    encode(to, r.cumulative_gas_used);
+    encode(to, r.success);
+    to.prepend_list_header(payload_end);
 }
 
 }  // namespace silkworm::rlp
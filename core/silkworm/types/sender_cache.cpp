@@ -0,0 +1,41 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sender_cache.hpp"
+
+namespace silkworm {
+
+std::optional<evmc::address> SenderCache::get(const evmc::bytes32& txn_hash) noexcept {
+#ifdef SILKWORM_CORE_THREADS
+    std::lock_guard lock{mutex_};
+#endif
+    const auto* sender{cache_.get(txn_hash)};
+    if (!sender) {
+        ++misses_;
+        return std::nullopt;
+    }
+    ++hits_;
+    return *sender;
+}
+
+void SenderCache::put(const evmc::bytes32& txn_hash, const evmc::address& sender) noexcept {
+#ifdef SILKWORM_CORE_THREADS
+    std::lock_guard lock{mutex_};
+#endif
+    cache_.put(txn_hash, sender);
+}
+
+}  // namespace silkworm
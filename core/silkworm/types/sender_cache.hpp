@@ -0,0 +1,72 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TYPES_SENDER_CACHE_H_
+#define SILKWORM_TYPES_SENDER_CACHE_H_
+
+#include <atomic>
+#include <evmc/evmc.hpp>
+#include <lrucache.hpp>
+#include <optional>
+#include <silkworm/common/base.hpp>
+
+#ifdef SILKWORM_CORE_THREADS
+#include <mutex>
+#endif
+
+namespace silkworm {
+
+/** @brief Cache of transaction senders by transaction hash.
+ *
+ * Saves the public key recovery of transactions seen before,
+ * e.g. when blocks are executed again after an unwind or a reorg.
+ * The least recently used senders are evicted beyond the maximum size.
+ * The cache may be shared between threads when built with SILKWORM_CORE_THREADS.
+ */
+class SenderCache {
+  public:
+    static constexpr size_t kDefaultMaxSize{100'000};
+
+    explicit SenderCache(size_t maxSize = kDefaultMaxSize) : cache_{maxSize} {}
+
+    SenderCache(const SenderCache&) = delete;
+    SenderCache& operator=(const SenderCache&) = delete;
+
+    /** @brief Gets the sender of a transaction from the cache.
+     * std::nullopt is returned if the transaction hasn't been recovered before.
+     */
+    std::optional<evmc::address> get(const evmc::bytes32& txn_hash) noexcept;
+
+    void put(const evmc::bytes32& txn_hash, const evmc::address& sender) noexcept;
+
+    // Number of lookups that found the sender, i.e. recoveries avoided
+    uint64_t hits() const noexcept { return hits_; }
+
+    // Number of lookups that didn't
+    uint64_t misses() const noexcept { return misses_; }
+
+  private:
+#ifdef SILKWORM_CORE_THREADS
+    std::mutex mutex_;
+#endif
+    cache::lru_cache<evmc::bytes32, evmc::address> cache_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace silkworm
+
+#endif  // SILKWORM_TYPES_SENDER_CACHE_H_
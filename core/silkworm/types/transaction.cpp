@@ -16,11 +16,15 @@
 
 #include "transaction.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstring>
-#include <ethash/keccak.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/crypto/ecdsa.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
 #include <silkworm/rlp/encode.hpp>
+#include <silkworm/types/sender_cache.hpp>
 namespace silkworm {
 
 bool operator==(const Transaction& a, const Transaction& b) {
@@ -49,37 +53,84 @@ namespace rlp {
     }
 
     size_t length(const Transaction& txn) {
+        txn.drop_stale_cache();
+        if (txn.cache) {
+            return txn.cache->rlp.length();
+        }
         Header rlp_head = rlp_header(txn, /*for_signing=*/false, {});
         return length_of_length(rlp_head.payload_length) + rlp_head.payload_length;
     }
 
-    void encode(Bytes& to, const Transaction& txn, bool for_signing, std::optional<uint64_t> eip155_chain_id) {
-        encode_header(to, rlp_header(txn, for_signing, eip155_chain_id));
-        encode(to, txn.nonce);
-        encode(to, txn.gas_price);
-        encode(to, txn.gas_limit);
-        if (txn.to) {
-            encode(to, txn.to->bytes);
-        } else {
-            to.push_back(kEmptyStringCode);
-        }
-        encode(to, txn.value);
-        encode(to, txn.data);
+    // Payload, back to front
+    static void encode_fields(ReverseEncoder& to, const Transaction& txn, bool for_signing,
+                              std::optional<uint64_t> eip155_chain_id) noexcept {
         if (!for_signing) {
-            encode(to, txn.v);
-            encode(to, txn.r);
             encode(to, txn.s);
+            encode(to, txn.r);
+            encode(to, txn.v);
         } else if (eip155_chain_id) {
-            encode(to, *eip155_chain_id);
             encode(to, 0);
             encode(to, 0);
-        };
+            encode(to, *eip155_chain_id);
+        }
+        encode(to, txn.data);
+        encode(to, txn.value);
+        if (txn.to) {
+            encode(to, txn.to->bytes);
+        } else {
+            to.prepend(kEmptyStringCode);
+        }
+        encode(to, txn.gas_limit);
+        encode(to, txn.gas_price);
+        encode(to, txn.nonce);
     }
 
-    void encode(Bytes& to, const Transaction& txn) { encode(to, txn, /*for_signing=*/false, {}); }
+    void encode(Bytes& to, const Transaction& txn, bool for_signing, std::optional<uint64_t> eip155_chain_id) {
+        const Header h{rlp_header(txn, for_signing, eip155_chain_id)};
+        const size_t old_length{to.length()};
+        ReverseEncoder encoder{to, length_of_length(h.payload_length) + h.payload_length};
+        encode_fields(encoder, txn, for_signing, eip155_chain_id);
+        encoder.prepend_header(h);
+        assert(encoder.position() == to.data() + old_length);
+    }
+
+    void encode(Bytes& to, const Transaction& txn) {
+        txn.drop_stale_cache();
+        if (txn.cache) {
+            to.append(txn.cache->rlp);
+            return;
+        }
+        encode(to, txn, /*for_signing=*/false, {});
+    }
+
+    void encode(ReverseEncoder& to, const Transaction& txn) noexcept {
+        txn.drop_stale_cache();
+        if (txn.cache) {
+            to.prepend(txn.cache->rlp);
+            return;
+        }
+        const uint8_t* payload_end{to.position()};
+        encode_fields(to, txn, /*for_signing=*/false, {});
+        to.prepend_list_header(payload_end);
+    }
+
+    // Payload of a numeric field, which must fit into max_length bytes without leading zeros
+    static DecodingResult decode_numeric(ByteView& from, ByteView& to, size_t max_length) noexcept {
+        if (DecodingResult err{decode(from, to)}; err != DecodingResult::kOk) {
+            return err;
+        }
+        if (to.length() > max_length) {
+            return DecodingResult::kOverflow;
+        }
+        if (!to.empty() && to[0] == 0) {
+            return DecodingResult::kLeadingZero;
+        }
+        return DecodingResult::kOk;
+    }
 
     template <>
-    DecodingResult decode(ByteView& from, Transaction& to) noexcept {
+    DecodingResult decode(ByteView& from, TransactionView& to) noexcept {
+        const ByteView start{from};
         auto [h, err]{decode_header(from)};
         if (err != DecodingResult::kOk) {
             return err;
@@ -88,78 +139,232 @@ namespace rlp {
             return DecodingResult::kUnexpectedString;
         }
         uint64_t leftover{from.length() - h.payload_length};
+        const ByteView payload{from};
 
-        if (DecodingResult err{decode(from, to.nonce)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode_numeric(from, to.nonce_, sizeof(uint64_t))}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.gas_price)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode_numeric(from, to.gas_price_, kHashLength)}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.gas_limit)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode_numeric(from, to.gas_limit_, sizeof(uint64_t))}; err != DecodingResult::kOk) {
             return err;
         }
-
-        if (from[0] == kEmptyStringCode) {
-            to.to = {};
-            from.remove_prefix(1);
-        } else {
-            to.to = evmc::address{};
-            if (DecodingResult err{decode(from, to.to->bytes)}; err != DecodingResult::kOk) {
-                return err;
-            }
+        if (DecodingResult err{decode(from, to.to_)}; err != DecodingResult::kOk) {
+            return err;
         }
-
-        if (DecodingResult err{decode(from, to.value)}; err != DecodingResult::kOk) {
+        if (!to.to_.empty() && to.to_.length() != kAddressLength) {
+            return DecodingResult::kUnexpectedLength;
+        }
+        if (DecodingResult err{decode_numeric(from, to.value_, kHashLength)}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.data)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode(from, to.data_)}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.v)}; err != DecodingResult::kOk) {
+        to.unsigned_rlp_ = payload.substr(0, payload.length() - from.length());
+
+        if (DecodingResult err{decode_numeric(from, to.v_, kHashLength)}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.r)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode_numeric(from, to.r_, kHashLength)}; err != DecodingResult::kOk) {
             return err;
         }
-        if (DecodingResult err{decode(from, to.s)}; err != DecodingResult::kOk) {
+        if (DecodingResult err{decode_numeric(from, to.s_, kHashLength)}; err != DecodingResult::kOk) {
             return err;
         }
 
-        return from.length() == leftover ? DecodingResult::kOk : DecodingResult::kListLengthMismatch;
+        if (from.length() != leftover) {
+            return DecodingResult::kListLengthMismatch;
+        }
+        to.rlp_ = start.substr(0, start.length() - from.length());
+        return DecodingResult::kOk;
+    }
+
+    template <>
+    DecodingResult decode(ByteView& from, Transaction& to) noexcept {
+        TransactionView view;
+        if (DecodingResult err{decode(from, view)}; err != DecodingResult::kOk) {
+            return err;
+        }
+        to = view.materialize();
+        return DecodingResult::kOk;
     }
 
 }  // namespace rlp
 
-void Transaction::recover_sender(bool homestead, std::optional<uint64_t> eip155_chain_id) {
-    from.reset();
+uint64_t TransactionView::nonce() const noexcept { return rlp::read_uint64(nonce_).first; }
 
-    if (!silkworm::ecdsa::is_valid_signature(r, s, homestead)) {
-        return;
+intx::uint256 TransactionView::gas_price() const noexcept { return rlp::read_uint256(gas_price_).first; }
+
+uint64_t TransactionView::gas_limit() const noexcept { return rlp::read_uint64(gas_limit_).first; }
+
+std::optional<evmc::address> TransactionView::to() const noexcept {
+    if (to_.empty()) {
+        return std::nullopt;
     }
+    return to_address(to_);
+}
+
+intx::uint256 TransactionView::value() const noexcept { return rlp::read_uint256(value_).first; }
+
+intx::uint256 TransactionView::v() const noexcept { return rlp::read_uint256(v_).first; }
 
-    ecdsa::RecoveryId x{ecdsa::get_signature_recovery_id(v)};
-    if (x.eip155_chain_id && x.eip155_chain_id != eip155_chain_id) {
+intx::uint256 TransactionView::r() const noexcept { return rlp::read_uint256(r_).first; }
+
+intx::uint256 TransactionView::s() const noexcept { return rlp::read_uint256(s_).first; }
+
+void TransactionView::encode_for_signing(Bytes& to, std::optional<uint64_t> eip155_chain_id) const {
+    rlp::Header h{true, unsigned_rlp_.length()};
+    if (eip155_chain_id) {
+        h.payload_length += rlp::length(*eip155_chain_id) + 2;
+    }
+    rlp::encode_header(to, h);
+    to.append(unsigned_rlp_);
+    if (eip155_chain_id) {
+        rlp::encode(to, *eip155_chain_id);
+        rlp::encode(to, 0);
+        rlp::encode(to, 0);
+    }
+}
+
+// Records the fields the cached encoding was just made of
+static void key_cache(const Transaction& txn) {
+    Transaction::Cache::Key& key{txn.cache->key};
+    key.nonce = txn.nonce;
+    key.gas_price = txn.gas_price;
+    key.gas_limit = txn.gas_limit;
+    key.to = txn.to;
+    key.value = txn.value;
+    // The payload of data is followed by the signature, which ends the encoding
+    key.data_length = txn.data.length();
+    key.data_offset = txn.cache->rlp.length() - rlp::length(txn.v) - rlp::length(txn.r) - rlp::length(txn.s) -
+                      key.data_length;
+    key.v = txn.v;
+    key.r = txn.r;
+    key.s = txn.s;
+}
+
+Transaction TransactionView::materialize() const {
+    Transaction txn{nonce(), gas_price(), gas_limit(), to(), value(), Bytes{data_}, v(), r(), s()};
+    txn.cache.emplace().rlp = rlp_;
+    key_cache(txn);
+    return txn;
+}
+
+void Transaction::drop_stale_cache() const {
+    if (!cache) {
         return;
     }
+    const Cache::Key& key{cache->key};
+    if (key.nonce != nonce || key.gas_price != gas_price || key.gas_limit != gas_limit || key.to != to ||
+        key.value != value || key.v != v || key.r != r || key.s != s || key.data_length != data.length() ||
+        std::memcmp(&cache->rlp[key.data_offset], data.data(), key.data_length) != 0) {
+        cache.reset();
+    }
+}
+
+ByteView Transaction::encoded() const {
+    drop_stale_cache();
+    if (!cache) {
+        rlp::encode(cache.emplace().rlp, *this, /*for_signing=*/false, {});
+        key_cache(*this);
+    }
+    return cache->rlp;
+}
 
-    Bytes rlp{};
-    bool for_signing{true};
-    if (x.eip155_chain_id) {
-        rlp::encode(rlp, *this, for_signing, eip155_chain_id);
-    } else {
-        rlp::encode(rlp, *this, for_signing, {});
+evmc::bytes32 Transaction::hash() const {
+    const ByteView rlp{encoded()};
+    if (!cache->hash) {
+        cache->hash = to_bytes32(full_view(keccak256(rlp).bytes));
     }
-    ethash::hash256 hash{keccak256(rlp)};
+    return *cache->hash;
+}
+
+void Transaction::recover_sender(bool homestead, std::optional<uint64_t> eip155_chain_id) {
+    recover_senders({this, 1}, homestead, eip155_chain_id);
+}
 
-    uint8_t signature[32 * 2];
-    intx::be::unsafe::store(signature, r);
-    intx::be::unsafe::store(signature + 32, s);
+void recover_senders(gsl::span<Transaction> txns, bool homestead, std::optional<uint64_t> eip155_chain_id,
+                     SenderCache* sender_cache) {
+    constexpr size_t kBatchSize{16};
 
-    std::optional<Bytes> recovered{ecdsa::recover(full_view(hash.bytes), full_view(signature), x.recovery_id)};
-    if (recovered) {
-        hash = ethash::keccak256(recovered->data() + 1, recovered->length() - 1);
-        from = evmc::address{};
-        std::memcpy(from->bytes, &hash.bytes[12], 32 - 12);
+    std::array<Bytes, kBatchSize> rlp;
+    std::array<ByteView, kBatchSize> inputs;
+    std::array<ethash::hash256, kBatchSize> hashes;
+    std::array<Transaction*, kBatchSize> to_hash;
+    std::array<Transaction*, kBatchSize> pending;
+    std::array<uint8_t, kBatchSize> recovery_ids;
+    std::array<ecdsa::PublicKey, kBatchSize> public_keys;
+
+    for (size_t begin{0}; begin < static_cast<size_t>(txns.size()); begin += kBatchSize) {
+        const size_t end{std::min(begin + kBatchSize, static_cast<size_t>(txns.size()))};
+
+        // Signing hashes of the transactions with a valid signature, unless already known
+        size_t n{0};
+        size_t k{0};
+        for (size_t i{begin}; i < end; ++i) {
+            Transaction& txn{txns[i]};
+            txn.from.reset();
+
+            if (!silkworm::ecdsa::is_valid_signature(txn.r, txn.s, homestead)) {
+                continue;
+            }
+
+            ecdsa::RecoveryId x{ecdsa::get_signature_recovery_id(txn.v)};
+            if (x.eip155_chain_id && x.eip155_chain_id != eip155_chain_id) {
+                continue;
+            }
+
+            if (sender_cache) {
+                if (std::optional<evmc::address> sender{sender_cache->get(txn.hash())}; sender) {
+                    txn.from = sender;
+                    continue;
+                }
+            }
+
+            const std::optional<uint64_t> signing_chain_id{x.eip155_chain_id ? eip155_chain_id : std::nullopt};
+            txn.encoded();  // Validates the cache & keys the signing hash
+            if (!txn.cache->signing_hash || txn.cache->signing_chain_id != signing_chain_id) {
+                rlp[k].clear();
+                rlp::encode(rlp[k], txn, /*for_signing=*/true, signing_chain_id);
+                inputs[k] = rlp[k];
+                to_hash[k] = &txn;
+                txn.cache->signing_chain_id = signing_chain_id;
+                ++k;
+            }
+            pending[n] = &txn;
+            recovery_ids[n] = x.recovery_id;
+            ++n;
+        }
+        crypto::keccak256_batch({hashes.data(), k}, {inputs.data(), k});
+        for (size_t i{0}; i < k; ++i) {
+            to_hash[i]->cache->signing_hash = to_bytes32(full_view(hashes[i].bytes));
+        }
+
+        // Public keys, whose hashes give the senders
+        size_t m{0};
+        for (size_t i{0}; i < n; ++i) {
+            const Transaction& txn{*pending[i]};
+            uint8_t signature[32 * 2];
+            intx::be::unsafe::store(signature, txn.r);
+            intx::be::unsafe::store(signature + 32, txn.s);
+            if (ecdsa::recover(public_keys[m], full_view(*txn.cache->signing_hash), {signature, sizeof(signature)},
+                               recovery_ids[i])) {
+                inputs[m] = ByteView{&public_keys[m][1], public_keys[m].size() - 1};
+                pending[m] = pending[i];
+                ++m;
+            }
+        }
+        crypto::keccak256_batch({hashes.data(), m}, {inputs.data(), m});
+
+        for (size_t i{0}; i < m; ++i) {
+            pending[i]->from = evmc::address{};
+            std::memcpy(pending[i]->from->bytes, &hashes[i].bytes[12], 32 - 12);
+            if (sender_cache) {
+                sender_cache->put(pending[i]->hash(), *pending[i]->from);
+            }
+        }
     }
 }
 }  // namespace silkworm
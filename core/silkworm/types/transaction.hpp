@@ -18,12 +18,16 @@
 #define SILKWORM_TYPES_TRANSACTION_H_
 
 #include <evmc/evmc.hpp>
+#include <gsl/span>
 #include <intx/intx.hpp>
+#include <memory>
 #include <optional>
 #include <silkworm/rlp/decode.hpp>
 
 namespace silkworm {
 
+class SenderCache;
+
 struct Transaction {
     uint64_t nonce{0};
     intx::uint256 gas_price;
@@ -34,6 +38,66 @@ struct Transaction {
     intx::uint256 v, r, s;              // signature
     std::optional<evmc::address> from;  // sender recovered from the signature
 
+    // Encoding & hashes of the transaction, computed at most once and allocated apart from the fields.
+    // The hashes are only cached along with the encoding, which is keyed on the fields it was made of:
+    // the whole cache is dropped on access once they differ, so modifying a field never leaves it stale.
+    // Copies start without a cache while moves keep it; ignored by operator==.
+    // Not thread-safe: encoded, hash & recover_senders fill the cache even through a const transaction,
+    // so they mustn't be called concurrently on the same transaction.
+    struct Cache {
+        Bytes rlp;
+        std::optional<evmc::bytes32> hash;
+        std::optional<evmc::bytes32> signing_hash;
+        std::optional<uint64_t> signing_chain_id;  // that signing_hash was calculated with
+
+        // Fields rlp was made of, but data which is compared with its slice of rlp
+        struct Key {
+            uint64_t nonce{0};
+            intx::uint256 gas_price;
+            uint64_t gas_limit{0};
+            std::optional<evmc::address> to;
+            intx::uint256 value;
+            size_t data_offset{0};
+            size_t data_length{0};
+            intx::uint256 v, r, s;
+        } key;
+    };
+
+    // Owner of the cache, if any
+    class CachePtr {
+      public:
+        CachePtr() noexcept = default;
+        CachePtr(const CachePtr&) noexcept {}
+        CachePtr(CachePtr&&) noexcept = default;
+        CachePtr& operator=(const CachePtr&) noexcept {
+            reset();
+            return *this;
+        }
+        CachePtr& operator=(CachePtr&&) noexcept = default;
+
+        explicit operator bool() const noexcept { return ptr_ != nullptr; }
+        Cache* operator->() const noexcept { return ptr_.get(); }
+
+        Cache& emplace() {
+            ptr_ = std::make_unique<Cache>();
+            return *ptr_;
+        }
+        void reset() noexcept { ptr_.reset(); }
+
+      private:
+        std::unique_ptr<Cache> ptr_;
+    };
+    mutable CachePtr cache{};
+
+    // RLP encoding, as decoded or else encoded on first use
+    ByteView encoded() const;
+
+    // Keccak-256 of the RLP encoding
+    evmc::bytes32 hash() const;
+
+    // Drops the cache unless the fields (other than from) still match its encoding
+    void drop_stale_cache() const;
+
     // Populates the from field with recovered sender.
     // See Yellow Paper, Appendix F "Signing Transactions",
     // https://eips.ethereum.org/EIPS/eip-2 and
@@ -44,6 +108,62 @@ struct Transaction {
 
 bool operator==(const Transaction& a, const Transaction& b);
 
+class TransactionView;
+
+namespace rlp {
+    template <>
+    DecodingResult decode(ByteView& from, TransactionView& to) noexcept;
+}
+
+// Read-only view of an RLP-encoded transaction, pointing into the encoding instead of copying out of it.
+// The structure is validated once by rlp::decode, while numeric fields are only decoded when accessed.
+// The encoding must outlive the view.
+class TransactionView {
+  public:
+    // The whole encoding, whose keccak is the transaction hash
+    ByteView rlp() const { return rlp_; }
+
+    uint64_t nonce() const noexcept;
+    intx::uint256 gas_price() const noexcept;
+    uint64_t gas_limit() const noexcept;
+    std::optional<evmc::address> to() const noexcept;
+    intx::uint256 value() const noexcept;
+    ByteView data() const { return data_; }
+    intx::uint256 v() const noexcept;
+    intx::uint256 r() const noexcept;
+    intx::uint256 s() const noexcept;
+
+    // Same as rlp::encode for signing, except that the fields are copied rather than re-encoded
+    void encode_for_signing(Bytes& to, std::optional<uint64_t> eip155_chain_id) const;
+
+    // Copies the fields, as well as the encoding, into an owned transaction
+    Transaction materialize() const;
+
+  private:
+    friend rlp::DecodingResult rlp::decode<TransactionView>(ByteView& from, TransactionView& to) noexcept;
+
+    ByteView rlp_;
+    ByteView unsigned_rlp_;  // encoded fields from nonce to data
+
+    // Payloads of the fields
+    ByteView nonce_;
+    ByteView gas_price_;
+    ByteView gas_limit_;
+    ByteView to_;
+    ByteView value_;
+    ByteView data_;
+    ByteView v_;
+    ByteView r_;
+    ByteView s_;
+};
+
+// Same as Transaction::recover_sender for every transaction,
+// except that signing hashes & public key hashes are calculated in batches.
+// Signing hashes are cached on the transactions.
+// Senders are looked up in & added to sender_cache unless it's null.
+void recover_senders(gsl::span<Transaction> txns, bool homestead, std::optional<uint64_t> eip155_chain_id,
+                     SenderCache* sender_cache = nullptr);
+
 namespace rlp {
     void encode(Bytes& to, const Transaction& txn, bool for_signing, std::optional<uint64_t> eip155_chain_id);
 
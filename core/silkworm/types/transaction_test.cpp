@@ -18,6 +18,8 @@
 
 #include <catch2/catch.hpp>
 #include <silkworm/common/util.hpp>
+#include <silkworm/crypto/ecdsa.hpp>
+#include <silkworm/types/sender_cache.hpp>
 
 namespace silkworm {
 
@@ -42,6 +44,39 @@ TEST_CASE("Transaction RLP") {
     ByteView view{encoded};
     REQUIRE(rlp::decode<Transaction>(view, decoded) == rlp::DecodingResult::kOk);
     CHECK(decoded == txn);
+
+    // Fields of the view point into the encoding
+    encoded.push_back(0xc0);  // whatever follows the transaction
+    view = encoded;
+    TransactionView txn_view;
+    REQUIRE(rlp::decode(view, txn_view) == rlp::DecodingResult::kOk);
+    CHECK(view.length() == 1);
+    CHECK(txn_view.rlp() == ByteView{encoded}.substr(0, encoded.length() - 1));
+    CHECK(txn_view.nonce() == txn.nonce);
+    CHECK(txn_view.gas_price() == txn.gas_price);
+    CHECK(txn_view.to() == txn.to);
+    CHECK(txn_view.data() == txn.data);
+    CHECK(txn_view.data().data() >= encoded.data());
+    CHECK(txn_view.s() == txn.s);
+    CHECK(txn_view.materialize() == txn);
+
+    for (std::optional<uint64_t> chain_id : {std::optional<uint64_t>{}, std::optional<uint64_t>{1}}) {
+        Bytes expected{}, actual{};
+        rlp::encode(expected, txn, /*for_signing=*/true, chain_id);
+        txn_view.encode_for_signing(actual, chain_id);
+        CHECK(to_hex(actual) == to_hex(expected));
+    }
+
+    // Contract creation & a nonce with a leading zero
+    txn.to.reset();
+    encoded.clear();
+    rlp::encode(encoded, txn);
+    view = encoded;
+    REQUIRE(rlp::decode(view, txn_view) == rlp::DecodingResult::kOk);
+    CHECK(!txn_view.to());
+    encoded[2] = 0x00;  // 0x0c -> 0x00
+    view = encoded;
+    CHECK(rlp::decode(view, txn_view) == rlp::DecodingResult::kLeadingZero);
 }
 
 TEST_CASE("Recover sender 1") {
@@ -82,4 +117,97 @@ TEST_CASE("Recover sender 2") {
     CHECK(txn.from == 0xa1e4380a3b1f749673e270229993ee55f35663b4_address);
 }
 
+TEST_CASE("Transaction hash") {
+    // https://etherscan.io/tx/0x5c504ed432cb51138bcf09aa5e8a410dd4a1e204ef84bfed1be16dfba1b22060
+    Transaction txn{
+        0,                                                   // nonce
+        50'000 * kGiga,                                      // gas_price
+        21'000,                                              // gas_limit
+        0x5df9b87991262f6ba471f09758cde1c0fc1de734_address,  // to
+        31337,                                               // value
+        {},                                                  // data
+        28,                                                  // v
+        intx::from_string<intx::uint256>("0x88ff6cf0fefd94db46111149ae4bfc179e9b94721fffd821d38d16464b3f71d0"),  // r
+        intx::from_string<intx::uint256>("0x45e0aff800961cfce805daef7016b9b675c137a6a41a548f7b60a3484c06a33a"),  // s
+    };
+    const auto expected_hash{0x5c504ed432cb51138bcf09aa5e8a410dd4a1e204ef84bfed1be16dfba1b22060_bytes32};
+
+    CHECK(txn.hash() == expected_hash);
+    REQUIRE(txn.cache);
+    CHECK(txn.cache->hash == expected_hash);
+    Bytes encoded{};
+    rlp::encode(encoded, txn);
+    CHECK(txn.encoded() == encoded);
+
+    // The encoding is kept from decoding
+    Transaction decoded;
+    ByteView view{encoded};
+    REQUIRE(rlp::decode(view, decoded) == rlp::DecodingResult::kOk);
+    REQUIRE(decoded.cache);
+    CHECK(decoded.cache->rlp == encoded);
+    CHECK(!decoded.cache->hash);
+    CHECK(decoded.hash() == expected_hash);
+
+    // The signing hash is kept from sender recovery
+    Bytes signing_rlp{};
+    rlp::encode(signing_rlp, txn, /*for_signing=*/true, {});
+    decoded.recover_sender(/*homestead=*/false, {});
+    CHECK(decoded.cache->signing_hash == to_bytes32(full_view(keccak256(signing_rlp).bytes)));
+    CHECK(!decoded.cache->signing_chain_id);
+
+    // Until the transaction is modified
+    decoded.nonce = 1;
+    CHECK(decoded.hash() != expected_hash);
+    CHECK(!decoded.cache->signing_hash);
+    txn.nonce = 1;
+    CHECK(decoded.hash() == txn.hash());
+    Bytes modified_rlp{};
+    rlp::encode(modified_rlp, decoded);
+    CHECK(modified_rlp == decoded.cache->rlp);
+    CHECK(modified_rlp != encoded);
+
+    // Including data modified in place
+    decoded.data = *from_hex("abcd");
+    const evmc::bytes32 hash_with_data{decoded.hash()};
+    decoded.data[1] = 0xef;
+    Transaction uncached{decoded};
+    CHECK(!uncached.cache);  // copies start without a cache
+    CHECK(decoded.hash() != hash_with_data);
+    CHECK(decoded.hash() == uncached.hash());
+}
+
+TEST_CASE("Sender cache") {
+    // https://etherscan.io/tx/0x5c504ed432cb51138bcf09aa5e8a410dd4a1e204ef84bfed1be16dfba1b22060
+    Transaction txn{
+        0,                                                   // nonce
+        50'000 * kGiga,                                      // gas_price
+        21'000,                                              // gas_limit
+        0x5df9b87991262f6ba471f09758cde1c0fc1de734_address,  // to
+        31337,                                               // value
+        {},                                                  // data
+        28,                                                  // v
+        intx::from_string<intx::uint256>("0x88ff6cf0fefd94db46111149ae4bfc179e9b94721fffd821d38d16464b3f71d0"),  // r
+        intx::from_string<intx::uint256>("0x45e0aff800961cfce805daef7016b9b675c137a6a41a548f7b60a3484c06a33a"),  // s
+    };
+    const evmc::address sender{0xa1e4380a3b1f749673e270229993ee55f35663b4_address};
+
+    SenderCache cache;
+    recover_senders({&txn, 1}, /*homestead=*/false, {}, &cache);
+    CHECK(txn.from == sender);
+    CHECK(cache.hits() == 0);
+    CHECK(cache.misses() == 1);
+    CHECK(cache.get(txn.hash()) == sender);
+
+    // Signature rules still apply to cached senders
+    Transaction high_s{txn};
+    high_s.s = ecdsa::kSecp256k1n - txn.s;
+    cache.put(high_s.hash(), sender);
+    recover_senders({&high_s, 1}, /*homestead=*/true, {}, &cache);
+    CHECK(!high_s.from);
+    const uint64_t hits{cache.hits()};
+    recover_senders({&high_s, 1}, /*homestead=*/false, {}, &cache);
+    CHECK(high_s.from == sender);
+    CHECK(cache.hits() == hits + 1);
+}
+
 }  // namespace silkworm
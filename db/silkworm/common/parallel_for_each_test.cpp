@@ -0,0 +1,49 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <silkworm/common/parallel_for_each.hpp>
+#include <stdexcept>
+
+namespace silkworm {
+
+// Core tests are built without exceptions
+TEST_CASE("Parallel for each rethrows") {
+    std::atomic<size_t> calls{0};
+    CHECK_THROWS_WITH(parallel_for_each(100'000, 4,
+                                        [&calls](size_t) {
+                                            ++calls;
+                                            throw std::runtime_error("failed");
+                                        }),
+                      "failed");
+    // No more items are handed out once a call has thrown
+    CHECK(calls <= 4);
+
+    calls = 0;
+    CHECK_THROWS_AS(parallel_for_each(100'000, 4,
+                                      [&calls](size_t i) {
+                                          ++calls;
+                                          if (i == 50'000) {
+                                              throw std::runtime_error("failed");
+                                          }
+                                      }),
+                    std::runtime_error);
+    CHECK(calls >= 1);
+}
+
+}  // namespace silkworm
@@ -117,8 +117,18 @@ namespace db {
             storage_body.txn_count = body.transactions.size();
             storage_body.ommers = body.ommers;
 
+            const Bytes stored_body{storage_body.encode()};
+            ByteView stored_view{stored_body};
+            const auto body_view{detail::decode_stored_block_body_view(stored_view)};
+            CHECK(stored_view.empty());
+            CHECK(body_view.base_txn_id == storage_body.base_txn_id);
+            CHECK(body_view.txn_count == storage_body.txn_count);
+            Bytes ommers_rlp{};
+            rlp::encode(ommers_rlp, body.ommers);
+            CHECK(body_view.ommers == ommers_rlp);
+
             auto body_table{txn->open(table::kBlockBodies)};
-            body_table->put(key, storage_body.encode());
+            body_table->put(key, stored_body);
 
             auto txn_table{txn->open(table::kEthTx)};
             Bytes txn_key(8, '\0');
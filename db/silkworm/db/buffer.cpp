@@ -44,6 +44,7 @@ void Buffer::update_account(const evmc::address& address, std::optional<Account>
                             std::optional<Account> current) {
     bool equal{current == initial};
     bool account_deleted{!current};
+    trie_updates_.reset();
 
     if (equal && !account_deleted && !changed_storage_.contains(address)) {
         // Follows the Turbo-Geth logic when to populate account changes.
@@ -90,6 +91,7 @@ void Buffer::update_storage(const evmc::address& address, uint64_t incarnation,
     if (current == initial) {
         return;
     }
+    trie_updates_.reset();
     changed_storage_.insert(address);
     ByteView change_val{zeroless_view(initial)};
     if (storage_changes_[block_number_][address][incarnation].insert_or_assign(location, change_val).second) {
@@ -157,6 +159,41 @@ void Buffer::write_to_state_table() {
     }
 }
 
+trie::HashedStateChanges Buffer::hashed_state_changes() const {
+    trie::HashedStateChanges changes;
+    for (const auto& [address, account] : accounts_) {
+        changes.accounts.emplace(to_bytes32(full_view(keccak256(full_view(address)).bytes)), account);
+    }
+    for (const auto& [address, contracts] : storage_) {
+        evmc::bytes32 hashed_address{to_bytes32(full_view(keccak256(full_view(address)).bytes))};
+        for (const auto& [incarnation, contract_storage] : contracts) {
+            auto& hashed_storage{changes.storage[trie::hashed_storage_prefix(hashed_address, incarnation)]};
+            for (const auto& [location, value] : contract_storage) {
+                hashed_storage.emplace(to_bytes32(full_view(keccak256(full_view(location)).bytes)), value);
+            }
+        }
+    }
+    return changes;
+}
+
+void Buffer::write_to_hashed_state_table(const trie::HashedStateChanges& changes) {
+    auto state_table{txn_->open(table::kCurrentState)};
+
+    for (const auto& [hashed_address, account] : changes.accounts) {
+        state_table->del(full_view(hashed_address));
+        if (account) {
+            bool omit_code_hash{false};
+            state_table->put(full_view(hashed_address), account->encode_for_storage(omit_code_hash));
+        }
+    }
+
+    for (const auto& [prefix, hashed_storage] : changes.storage) {
+        for (const auto& [hashed_location, value] : hashed_storage) {
+            upsert_storage_value(*state_table, prefix, hashed_location, value);
+        }
+    }
+}
+
 void Buffer::write_to_db() {
     if (!txn_) {
         return;
@@ -164,6 +201,18 @@ void Buffer::write_to_db() {
 
     write_to_state_table();
 
+    // Keep the hashed state & intermediate hashes in sync with the plain state (if asked to).
+    // Without a prior state root calculation the intermediate hashes of changed paths are just dropped.
+    if (maintain_hashed_state_) {
+        trie::HashedStateChanges changes{hashed_state_changes()};
+        write_to_hashed_state_table(changes);
+        if (trie_updates_) {
+            trie_updates_->write_to_db(*txn_);
+        } else {
+            trie::invalidate_intermediate_hashes(*txn_, changes);
+        }
+    }
+
     auto incarnation_table{txn_->open(table::kIncarnationMap)};
     Bytes data(kIncarnationLength, '\0');
     for (const auto& entry : incarnations_) {
@@ -244,7 +293,18 @@ void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>&
     }
 }
 
-evmc::bytes32 Buffer::state_root_hash() const { throw std::runtime_error("not yet implemented"); }
+evmc::bytes32 Buffer::state_root_hash() const {
+    if (!txn_ || historical_block_) {
+        throw std::runtime_error("state root requires a transaction on the current state");
+    }
+    if (!maintain_hashed_state_) {
+        throw std::runtime_error("state root requires hashed state maintenance");
+    }
+    trie::IntermediateHashUpdates updates;
+    evmc::bytes32 root{trie::calculate_state_root(*txn_, hashed_state_changes(), &updates)};
+    trie_updates_ = std::move(updates);
+    return root;
+}
 
 uint64_t Buffer::current_canonical_block() const { throw std::runtime_error("not yet implemented"); }
 
@@ -26,6 +26,7 @@
 #include <silkworm/db/chaindb.hpp>
 #include <silkworm/db/util.hpp>
 #include <silkworm/state/buffer.hpp>
+#include <silkworm/trie/intermediate_hashes.hpp>
 #include <silkworm/types/account.hpp>
 #include <silkworm/types/block.hpp>
 #include <silkworm/types/receipt.hpp>
@@ -59,6 +60,11 @@ class Buffer : public StateBuffer {
     std::optional<intx::uint256> total_difficulty(uint64_t block_number,
                                                   const evmc::bytes32& block_hash) const noexcept override;
 
+    /** State root hash with all buffered changes applied.
+     * Computed incrementally out of the hashed state and the intermediate hashes of the trie,
+     * so that only the paths to changed accounts & storage are recalculated.
+     * Requires hashed state maintenance (see maintain_hashed_state).
+     */
     evmc::bytes32 state_root_hash() const override;
 
     uint64_t current_canonical_block() const override;
@@ -107,11 +113,22 @@ class Buffer : public StateBuffer {
     /** Approximate size of accumulated DB changes in bytes.*/
     size_t current_batch_size() const noexcept { return batch_size_; }
 
+    /** Whether write_to_db also keeps the hashed state (kCurrentState) and the intermediate hashes
+     * (kIntermediateTrieHash) in sync with the plain state, as state_root_hash relies on them.
+     * Off by default : on a Turbo-Geth database those tables belong to its HashState & IntermediateHashes
+     * stages and the layout of intermediate hashes written here hasn't been verified against theirs.
+     */
+    void maintain_hashed_state(bool value) { maintain_hashed_state_ = value; }
+
     void write_to_db();
 
   private:
     void write_to_state_table();
 
+    void write_to_hashed_state_table(const trie::HashedStateChanges& changes);
+
+    trie::HashedStateChanges hashed_state_changes() const;
+
     void bump_batch_size(size_t key_len, size_t value_len);
 
     lmdb::Transaction* txn_{nullptr};
@@ -141,6 +158,11 @@ class Buffer : public StateBuffer {
     // Current block stuff
     uint64_t block_number_{0};
     absl::flat_hash_set<evmc::address> changed_storage_;
+
+    bool maintain_hashed_state_{false};
+
+    // Intermediate hashes matching the buffered changes as of the last state_root_hash() call, if any
+    mutable std::optional<trie::IntermediateHashUpdates> trie_updates_;
 };
 
 }  // namespace silkworm::db
@@ -166,8 +166,14 @@ int Environment::set_max_readers(const unsigned int count) { return mdb_env_set_
 
 int Environment::sync(const bool force) { return mdb_env_sync(handle_, force); }
 
-int Environment::get_ro_txns(void) noexcept { return ro_txns_[std::this_thread::get_id()]; }
-int Environment::get_rw_txns(void) noexcept { return rw_txns_[std::this_thread::get_id()]; }
+int Environment::get_ro_txns(void) noexcept {
+    std::lock_guard<std::mutex> l(count_mtx_);
+    return ro_txns_[std::this_thread::get_id()];
+}
+int Environment::get_rw_txns(void) noexcept {
+    std::lock_guard<std::mutex> l(count_mtx_);
+    return rw_txns_[std::this_thread::get_id()];
+}
 
 void Environment::touch_ro_txns(int count) noexcept {
     std::lock_guard<std::mutex> l(count_mtx_);
@@ -509,6 +515,7 @@ std::optional<db::Entry> Table::seek(ByteView prefix) {
 
 int Table::seek(MDB_val* key, MDB_val* data) { return get(key, data, MDB_SET_RANGE); }
 int Table::seek_exact(MDB_val* key, MDB_val* data) { return get(key, data, MDB_SET); }
+int Table::seek_dup(MDB_val* key, MDB_val* data) { return get(key, data, MDB_GET_BOTH_RANGE); }
 int Table::get_current(MDB_val* key, MDB_val* data) { return get(key, data, MDB_GET_CURRENT); }
 int Table::del_current(bool alldupkeys) {
     if (alldupkeys) {
@@ -289,6 +289,7 @@ class Table {
     std::optional<db::Entry> seek(ByteView prefix);  // Position cursor to first key >= of given prefix
     int seek(MDB_val* key, MDB_val* data);           // Position cursor to first key >= of given key
     int seek_exact(MDB_val* key, MDB_val* data);     // Position cursor to key == of given key
+    int seek_dup(MDB_val* key, MDB_val* data);       // Position cursor to first data >= of given data (only MDB_DUPSORT)
     int get_current(MDB_val* key, MDB_val* data);    // Gets data from current cursor position
     int del_current(bool alldupkeys = false);  // Delete key/data pair at current cursor position. alldupkeys may be set
                                                // true only for tables opened MDB_DUPSORT flag and in that case all
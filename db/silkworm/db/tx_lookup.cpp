@@ -0,0 +1,272 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "tx_lookup.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+#include <exception>
+#include <functional>
+#include <silkworm/common/log.hpp>
+#include <silkworm/crypto/keccak_batch.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <thread>
+
+namespace silkworm {
+
+// Out of db namespace as SILKWORM_LOG refers to (silkworm::)detail
+static void log_extraction_progress(uint64_t block_number) {
+    SILKWORM_LOG(LogInfo) << "Tx Lookup Extraction Progress << " << block_number << std::endl;
+}
+
+}  // namespace silkworm
+
+namespace silkworm::db::tx_lookup {
+
+// Checkpoint collected data every this number of blocks
+constexpr uint64_t kCheckpointEvery{100'000};
+
+std::string etl_work_path(const std::string& db_path) {
+    namespace fs = boost::filesystem;
+    return (fs::path(db_path).parent_path() / fs::path("etl-temp-tx_lookup")).string();
+}
+
+static Bytes compact(Bytes& b) {
+    std::string::size_type offset{b.find_first_not_of((uint8_t)0)};
+    if (offset != std::string::npos) {
+        return b.substr(offset);
+    }
+    return b;
+}
+
+Bytes encode_partition(const Partition& partition) {
+    Bytes ret(24, '\0');
+    boost::endian::store_big_u64(&ret[0], partition.from);
+    boost::endian::store_big_u64(&ret[8], partition.to);
+    boost::endian::store_big_u64(&ret[16], partition.processed);
+    return ret;
+}
+
+std::optional<Partition> decode_partition(ByteView cursor) {
+    if (cursor.length() != 24) {
+        return std::nullopt;
+    }
+    return Partition{boost::endian::load_big_u64(&cursor[0]), boost::endian::load_big_u64(&cursor[8]),
+                     boost::endian::load_big_u64(&cursor[16])};
+}
+
+// Returns the id of the first transaction of the first block at or above block_number,
+// or the id following the last transaction when there's no such block
+static uint64_t first_txn_id(lmdb::Table& bodies_table, uint64_t block_number) {
+    Bytes key(8, '\0');
+    boost::endian::store_big_u64(&key[0], block_number);
+    MDB_val mdb_key{to_mdb_val(key)};
+    MDB_val mdb_data;
+    int rc{bodies_table.seek(&mdb_key, &mdb_data)};
+    bool past_last{rc == MDB_NOTFOUND};
+    if (past_last) {
+        rc = bodies_table.get_last(&mdb_key, &mdb_data);
+        if (rc == MDB_NOTFOUND) {
+            return 0;
+        }
+    }
+    lmdb::err_handler(rc);
+    auto body_rlp{from_mdb_val(mdb_data)};
+    auto body{detail::decode_stored_block_body_view(body_rlp)};
+    return past_last ? body.base_txn_id + body.txn_count : body.base_txn_id;
+}
+
+std::vector<Partition> split_by_txn_count(lmdb::Table& bodies_table, uint64_t from, uint64_t to,
+                                          uint32_t num_partitions) {
+    const uint64_t first_id{first_txn_id(bodies_table, from)};
+    const uint64_t txn_count{first_txn_id(bodies_table, to + 1) - first_id};
+
+    std::vector<Partition> partitions;
+    uint64_t partition_from{from};
+    for (uint32_t i{1}; i <= num_partitions && partition_from <= to; ++i) {
+        // Lowest block whose transactions lie beyond this partition's share
+        uint64_t partition_end{to + 1};
+        if (i < num_partitions) {
+            const uint64_t target_id{first_id + txn_count * i / num_partitions};
+            for (uint64_t lo{partition_from}; lo < partition_end;) {
+                uint64_t mid{lo + (partition_end - lo) / 2};
+                if (first_txn_id(bodies_table, mid) > target_id) {
+                    partition_end = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+        }
+        if (partition_end > partition_from) {
+            partitions.push_back({partition_from, partition_end - 1, partition_from - 1});
+            partition_from = partition_end;
+        }
+    }
+    return partitions;
+}
+
+std::vector<Partition> resumable_partitions(const std::vector<Bytes>& cursors, uint64_t from,
+                                            uint64_t last_block) {
+    std::vector<Partition> partitions;
+    uint64_t expected_from{from};
+    for (const auto& cursor : cursors) {
+        auto partition{decode_partition(cursor)};
+        if (!partition.has_value() || partition->from != expected_from || partition->to < partition->from ||
+            partition->processed < partition->from - 1 || partition->processed > partition->to) {
+            return {};
+        }
+        partitions.push_back(*partition);
+        expected_from = partition->to + 1;
+    }
+    if (partitions.empty() || partitions.back().to > last_block) {
+        return {};
+    }
+    return partitions;
+}
+
+// Walks block bodies in range [from, to] handing every (tx hash => block number) entry to on_entry.
+// on_block is invoked once each block has been walked
+static void walk_tx_hashes(lmdb::Table& bodies_table, lmdb::Table& transactions_table, uint64_t from, uint64_t to,
+                           const std::function<void(etl::Entry&)>& on_entry,
+                           const std::function<void(uint64_t)>& on_block) {
+    Bytes start(8, '\0');
+    boost::endian::store_big_u64(&start[0], from);
+    MDB_val mdb_key{to_mdb_val(start)};
+    MDB_val mdb_data;
+    std::vector<ByteView> tx_rlps;
+    std::vector<ethash::hash256> tx_hashes;
+    int rc{bodies_table.seek(&mdb_key, &mdb_data)};  // Sets cursor to nearest key greater equal than this
+    while (!rc) {                                    /* Loop as long as we have no errors*/
+        Bytes block_number_as_bytes(static_cast<unsigned char*>(mdb_key.mv_data), 8);
+        auto block_number{boost::endian::load_big_u64(&block_number_as_bytes[0])};
+        if (block_number > to) {
+            break;
+        }
+        auto body_rlp{from_mdb_val(mdb_data)};
+        auto body{detail::decode_stored_block_body_view(body_rlp)};
+        auto lookup_block_data{compact(block_number_as_bytes)};
+        if (body.txn_count > 0) {
+            Bytes transaction_key(8, '\0');
+            boost::endian::store_big_u64(transaction_key.data(), body.base_txn_id);
+            MDB_val tx_key_mdb{to_mdb_val(transaction_key)};
+            MDB_val tx_data_mdb{};
+
+            // Take transactions rlp, then hash them in batches in order to get the transaction hashes.
+            // Views into the database are done with before any entry is handed out
+            tx_rlps.clear();
+            uint64_t i{0};
+            for (rc = transactions_table.seek_exact(&tx_key_mdb, &tx_data_mdb);
+                 rc != MDB_NOTFOUND && i < body.txn_count;
+                 rc = transactions_table.get_next(&tx_key_mdb, &tx_data_mdb), ++i) {
+                lmdb::err_handler(rc);
+                tx_rlps.push_back(from_mdb_val(tx_data_mdb));
+            }
+            tx_hashes.resize(tx_rlps.size());
+            crypto::keccak256_batch(tx_hashes, tx_rlps);
+            for (const auto& hash : tx_hashes) {
+                etl::Entry entry{Bytes(hash.bytes, 32), Bytes(lookup_block_data.data(), lookup_block_data.size())};
+                on_entry(entry);
+            }
+        }
+        on_block(block_number);
+        rc = bodies_table.get_next(&mdb_key, &mdb_data);
+    }
+
+    if (rc && rc != MDB_NOTFOUND) { /* MDB_NOTFOUND is not actually an error rather eof */
+        lmdb::err_handler(rc);
+    }
+}
+
+void extract_tx_hashes(lmdb::Environment& env, Partition partition, etl::ShardedCollector& collector,
+                       size_t shard) {
+    collector.checkpoint(shard, encode_partition(partition));
+    if (partition.processed >= partition.to) {
+        return;  // Already done by a previous run
+    }
+
+    std::unique_ptr<lmdb::Transaction> txn{env.begin_ro_transaction()};
+    auto bodies_table{txn->open(table::kBlockBodies)};
+    auto transactions_table{txn->open(table::kEthTx)};
+
+    walk_tx_hashes(
+        *bodies_table, *transactions_table, partition.processed + 1, partition.to,
+        [&](etl::Entry& entry) { collector.collect(shard, entry); },
+        [&](uint64_t block_number) {
+            if (block_number % kCheckpointEvery == 0) {
+                partition.processed = block_number;
+                collector.checkpoint(shard, encode_partition(partition));
+                log_extraction_progress(block_number);
+            }
+        });
+
+    partition.processed = partition.to;
+    collector.checkpoint(shard, encode_partition(partition));
+}
+
+size_t merge_tx_hashes(lmdb::Transaction& txn, uint64_t from, uint64_t to) {
+    auto bodies_table{txn.open(table::kBlockBodies)};
+    auto transactions_table{txn.open(table::kEthTx)};
+    auto target_table{txn.open(table::kTxLookup, MDB_CREATE)};
+
+    size_t count{0};
+    etl::Buffer buffer(etl::kOptimalBufferSize);
+    auto merge_buffer{[&]() {
+        buffer.sort();
+        etl::load_entries(buffer.get_entries(), target_table.get(), nullptr, /* db_flags = */ 0u,
+                          /* log_every_percent = */ 100u);
+        buffer.clear();
+    }};
+
+    walk_tx_hashes(
+        *bodies_table, *transactions_table, from, to,
+        [&](etl::Entry& entry) {
+            buffer.put(entry);
+            ++count;
+        },
+        [&](uint64_t) {
+            if (buffer.overflows()) {
+                merge_buffer();
+            }
+        });
+    merge_buffer();
+    return count;
+}
+
+void collect_tx_hashes(lmdb::Environment& env, const std::vector<Partition>& partitions,
+                       etl::ShardedCollector& collector) {
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(partitions.size());
+    for (size_t i{0}; i < partitions.size(); ++i) {
+        workers.emplace_back([&, i]() {
+            try {
+                extract_tx_hashes(env, partitions[i], collector, i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace silkworm::db::tx_lookup
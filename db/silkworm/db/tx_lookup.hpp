@@ -0,0 +1,85 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#ifndef SILKWORM_DB_TX_LOOKUP_H_
+#define SILKWORM_DB_TX_LOOKUP_H_
+
+// Extraction of the (tx hash => block number) mapping of TxLookup stage
+
+#include <optional>
+#include <silkworm/db/chaindb.hpp>
+#include <string>
+#include <silkworm/etl/sharded_collector.hpp>
+#include <vector>
+
+namespace silkworm::db::tx_lookup {
+
+/*
+ * Work dir of ETL files and manifest of an interrupted extraction, next to the database dir.
+ * It's a sibling of, not within, the "etl-temp" dir which other tools remove altogether once done
+ * (e.g. check_senders usually running right before) : a resume would find nothing left otherwise
+ */
+std::string etl_work_path(const std::string& db_path);
+
+// A contiguous range of blocks extracted by one thread
+struct Partition {
+    uint64_t from{0};       // First block (inclusive)
+    uint64_t to{0};         // Last block (inclusive)
+    uint64_t processed{0};  // Last block whose transactions have been collected
+};
+
+// Serializes a partition as an ETL checkpoint cursor
+Bytes encode_partition(const Partition& partition);
+std::optional<Partition> decode_partition(ByteView cursor);
+
+/*
+ * Splits blocks [from, to] into at most num_partitions contiguous partitions holding
+ * about the same number of transactions. Splitting by block count would be badly unbalanced
+ * as early mainnet blocks are nearly empty : the last threads would do most of the work.
+ * Transaction ids are assigned sequentially to bodies, hence each boundary is found bisecting
+ * the block range over the first transaction id of blocks
+ */
+std::vector<Partition> split_by_txn_count(lmdb::Table& bodies_table, uint64_t from, uint64_t to,
+                                          uint32_t num_partitions);
+
+/*
+ * Returns the partitions recorded by the cursors of an interrupted run or an empty vector if they
+ * can't be resumed. Shard i resumes partition i, hence every cursor must decode and partitions
+ * must be contiguous, cover blocks from the given one onwards and end no further than last_block :
+ * a dropped range would otherwise never be extracted while stage progress moves past it
+ */
+std::vector<Partition> resumable_partitions(const std::vector<Bytes>& cursors, uint64_t from,
+                                            uint64_t last_block);
+
+// Extracts tx hashes of blocks in partition's range not yet processed using a dedicated ro transaction
+// and collects them into the given shard. Progress is checkpointed so an interrupted run can resume
+void extract_tx_hashes(lmdb::Environment& env, Partition partition, etl::ShardedCollector& collector,
+                       size_t shard);
+
+// Extracts all partitions concurrently, each by a dedicated thread collecting into the shard of same index.
+// Rethrows the first error met by any thread
+void collect_tx_hashes(lmdb::Environment& env, const std::vector<Partition>& partitions,
+                       etl::ShardedCollector& collector);
+
+// Extracts tx hashes of blocks in range [from, to] within the rw transaction and merges them, sorted in
+// memory, directly into tx lookup table skipping ETL files altogether. Memory stays bounded as a batch
+// is merged every time the buffer overflows. Returns the number of entries merged
+size_t merge_tx_hashes(lmdb::Transaction& txn, uint64_t from, uint64_t to);
+
+}  // namespace silkworm::db::tx_lookup
+
+#endif  // !SILKWORM_DB_TX_LOOKUP_H_
@@ -0,0 +1,202 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "tx_lookup.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+#include <catch2/catch.hpp>
+#include <silkworm/common/temp_dir.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+
+namespace silkworm::db::tx_lookup {
+
+// Stores blocks [0, 1000] whose transactions all sit in the last 200 blocks, as on early mainnet.
+// Returns the number of transactions of each block
+static std::vector<uint64_t> populate_bodies(lmdb::Transaction& txn) {
+    auto bodies_table{txn.open(table::kBlockBodies)};
+    auto transactions_table{txn.open(table::kEthTx)};
+    std::vector<uint64_t> txn_counts;
+    uint64_t txn_id{0};
+    const uint8_t hash[kHashLength]{};
+    for (uint64_t block_number{0}; block_number <= 1000; ++block_number) {
+        detail::BlockBodyForStorage body{txn_id, block_number < 800 ? 0 : block_number - 790, {}};
+        bodies_table->put(block_key(block_number, hash), body.encode());
+        for (uint64_t i{0}; i < body.txn_count; ++i, ++txn_id) {
+            Bytes key(8, '\0');
+            boost::endian::store_big_u64(&key[0], txn_id);
+            transactions_table->put(key, key);  // Any payload is fine as long as hashes differ
+        }
+        txn_counts.push_back(body.txn_count);
+    }
+    return txn_counts;
+}
+
+TEST_CASE("Split by transaction count") {
+    TemporaryDirectory tmp_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    table::create_all(*txn);
+    auto txn_counts{populate_bodies(*txn)};
+    auto bodies_table{txn->open(table::kBlockBodies)};
+
+    for (uint32_t num_partitions : {1u, 2u, 4u, 7u}) {
+        auto partitions{split_by_txn_count(*bodies_table, 1, 1000, num_partitions)};
+        REQUIRE(partitions.size() == num_partitions);
+        CHECK(partitions.front().from == 1);
+        CHECK(partitions.back().to == 1000);
+
+        uint64_t overall_count{0};
+        std::vector<uint64_t> partition_counts;
+        for (size_t i{0}; i < partitions.size(); ++i) {
+            if (i) {
+                CHECK(partitions[i].from == partitions[i - 1].to + 1);
+            }
+            CHECK(partitions[i].processed == partitions[i].from - 1);
+            uint64_t count{0};
+            for (uint64_t block_number{partitions[i].from}; block_number <= partitions[i].to; ++block_number) {
+                count += txn_counts[block_number];
+            }
+            partition_counts.push_back(count);
+            overall_count += count;
+        }
+        // Within 5% of an even share
+        for (auto count : partition_counts) {
+            CHECK(count * num_partitions * 20 >= overall_count * 19);
+            CHECK(count * num_partitions * 20 <= overall_count * 21);
+        }
+    }
+
+    // No transactions at all : a single partition
+    CHECK(split_by_txn_count(*bodies_table, 1, 500, 4).size() == 1);
+}
+
+TEST_CASE("Resumable partitions") {
+    auto cursor{[](uint64_t from, uint64_t to, uint64_t processed) {
+        return encode_partition({from, to, processed});
+    }};
+
+    auto partitions{resumable_partitions({cursor(1, 10, 5), cursor(11, 20, 10)}, 1, 30)};
+    REQUIRE(partitions.size() == 2);
+    CHECK(partitions[1].from == 11);
+    CHECK(partitions[1].to == 20);
+    CHECK(partitions[1].processed == 10);
+
+    CHECK(resumable_partitions({}, 1, 20).empty());
+    CHECK(resumable_partitions({cursor(2, 10, 5)}, 1, 20).empty());                         // Not from stage progress
+    CHECK(resumable_partitions({cursor(1, 10, 5), cursor(12, 20, 11)}, 1, 20).empty());     // Gap
+    CHECK(resumable_partitions({cursor(1, 10, 5), Bytes{0x01}, cursor(11, 20, 10)}, 1, 20).empty());  // Undecodable
+    CHECK(resumable_partitions({cursor(1, 10, 11)}, 1, 20).empty());                        // Processed past end
+    CHECK(resumable_partitions({cursor(1, 10, 5), cursor(11, 20, 10)}, 1, 19).empty());     // Past last block
+}
+
+TEST_CASE("Incremental and ETL extraction agree") {
+    TemporaryDirectory tmp_dir;
+    TemporaryDirectory etl_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    {
+        auto txn{env->begin_rw_transaction()};
+        table::create_all(*txn);
+        populate_bodies(*txn);
+        lmdb::err_handler(txn->commit());
+    }
+
+    auto txn{env->begin_rw_transaction()};
+    CHECK(merge_tx_hashes(*txn, 1, 1000) == 22'110);
+    auto merged_table{txn->open(table::kTxLookup)};
+    size_t merged_count{0};
+    lmdb::err_handler(merged_table->get_rcount(&merged_count));
+    CHECK(merged_count == 22'110);
+
+    std::vector<std::pair<Bytes, Bytes>> merged;
+    MDB_val mdb_key, mdb_data;
+    for (int rc{merged_table->get_first(&mdb_key, &mdb_data)}; !rc;
+         rc = merged_table->get_next(&mdb_key, &mdb_data)) {
+        merged.emplace_back(from_mdb_val(mdb_key), from_mdb_val(mdb_data));
+    }
+    lmdb::err_handler(merged_table->clear());
+
+    {
+        auto bodies_table{txn->open(table::kBlockBodies)};
+        auto partitions{split_by_txn_count(*bodies_table, 1, 1000, 3)};
+
+        etl::ShardedCollector collector(partitions.size(), etl_dir.path());
+        collect_tx_hashes(*env, partitions, collector);
+        CHECK(collector.size() == 22'110);
+        auto target_table{txn->open(table::kTxLookup)};
+        collector.load(target_table.get(), nullptr, MDB_APPEND);
+    }
+
+    auto loaded_table{txn->open(table::kTxLookup)};
+    size_t i{0};
+    for (int rc{loaded_table->get_first(&mdb_key, &mdb_data)}; !rc;
+         rc = loaded_table->get_next(&mdb_key, &mdb_data), ++i) {
+        REQUIRE(i < merged.size());
+        CHECK(from_mdb_val(mdb_key) == merged[i].first);
+        CHECK(from_mdb_val(mdb_data) == merged[i].second);
+    }
+    CHECK(i == merged.size());
+}
+
+TEST_CASE("Interrupted extraction survives other ETL work dirs") {
+    namespace fs = boost::filesystem;
+
+    TemporaryDirectory tmp_dir;
+    TemporaryDirectory root_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    table::create_all(*txn);
+    populate_bodies(*txn);
+
+    // Laid out as a data dir : work dirs sit next to the database dir
+    const fs::path db_path{fs::path(root_dir.path()) / fs::path("chaindata")};
+    const std::string work_path{etl_work_path(db_path.string())};
+    fs::create_directories(work_path);
+
+    // Interrupted once all partitions are extracted but before loading
+    auto bodies_table{txn->open(table::kBlockBodies)};
+    const std::vector<Partition> partitions{split_by_txn_count(*bodies_table, 1, 1000, 2)};
+    {
+        etl::ShardedCollector collector(partitions.size(), work_path.c_str());
+        collect_tx_hashes(*env, partitions, collector);
+    }
+
+    // Another tool collecting in the shared work dir removes it when done
+    const fs::path shared_path{fs::path(root_dir.path()) / fs::path("etl-temp")};
+    fs::create_directories(shared_path);
+    {
+        etl::Collector other(shared_path.string().c_str());
+        etl::Entry entry{Bytes(8, '\x01'), Bytes(1, '\x02')};
+        other.collect(entry);
+    }
+    CHECK(!fs::exists(shared_path));
+
+    auto manifest{etl::read_manifest(work_path)};
+    REQUIRE(manifest.has_value());
+    CHECK(resumable_partitions(manifest->cursors, 1, 1000).size() == partitions.size());
+    etl::ShardedCollector collector(partitions.size(), work_path.c_str());
+    REQUIRE(collector.restore().has_value());
+    CHECK(collector.size() == 22'110);
+}
+
+}  // namespace silkworm::db::tx_lookup
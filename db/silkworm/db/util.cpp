@@ -144,10 +144,12 @@ namespace detail {
         header.payload_length += rlp::length(ommers);
 
         Bytes to;
-        rlp::encode_header(to, header);
-        rlp::encode(to, base_txn_id);
-        rlp::encode(to, txn_count);
-        rlp::encode(to, ommers);
+        rlp::ReverseEncoder encoder{to, rlp::length_of_length(header.payload_length) + header.payload_length};
+        rlp::encode(encoder, ommers);
+        rlp::encode(encoder, txn_count);
+        rlp::encode(encoder, base_txn_id);
+        encoder.prepend_header(header);
+        assert(encoder.position() == to.data());
         return to;
     }
 
@@ -157,7 +159,7 @@ namespace detail {
         }
     }
 
-    BlockBodyForStorage decode_stored_block_body(ByteView& from) {
+    BlockBodyForStorageView decode_stored_block_body_view(ByteView& from) {
         auto [header, err]{rlp::decode_header(from)};
         check_rlp_err(err);
         if (!header.list) {
@@ -165,10 +167,18 @@ namespace detail {
         }
         uint64_t leftover{from.length() - header.payload_length};
 
-        BlockBodyForStorage to;
+        BlockBodyForStorageView to;
         check_rlp_err(rlp::decode(from, to.base_txn_id));
         check_rlp_err(rlp::decode(from, to.txn_count));
-        check_rlp_err(rlp::decode_vector(from, to.ommers));
+
+        to.ommers = from;
+        auto [ommers_header, err2]{rlp::decode_header(from)};
+        check_rlp_err(err2);
+        if (!ommers_header.list) {
+            throw rlp::DecodingResult::kUnexpectedString;
+        }
+        from.remove_prefix(ommers_header.payload_length);
+        to.ommers = to.ommers.substr(0, to.ommers.length() - from.length());
 
         if (from.length() != leftover) {
             throw rlp::DecodingResult::kListLengthMismatch;
@@ -177,5 +187,15 @@ namespace detail {
         return to;
     }
 
+    BlockBodyForStorage decode_stored_block_body(ByteView& from) {
+        BlockBodyForStorageView view{decode_stored_block_body_view(from)};
+
+        BlockBodyForStorage to;
+        to.base_txn_id = view.base_txn_id;
+        to.txn_count = view.txn_count;
+        check_rlp_err(rlp::decode_vector(view.ommers, to.ommers));
+        return to;
+    }
+
 }  // namespace detail
 }  // namespace silkworm::db
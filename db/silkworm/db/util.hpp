@@ -103,6 +103,16 @@ namespace detail {
 
     BlockBodyForStorage decode_stored_block_body(ByteView& from);
 
+    // Same as BlockBodyForStorage except that the ommers are left encoded, pointing into the stored body;
+    // for the many readers that only need the transaction ids
+    struct BlockBodyForStorageView {
+        uint64_t base_txn_id{0};
+        uint64_t txn_count{0};
+        ByteView ommers;  // RLP list of the ommer headers
+    };
+
+    BlockBodyForStorageView decode_stored_block_body_view(ByteView& from);
+
 }  // namespace detail
 }  // namespace silkworm::db
 
@@ -18,14 +18,25 @@
 
 #include <boost/filesystem.hpp>
 #include <silkworm/common/log.hpp>
-#include <queue>
 #include <iomanip>
+#include <queue>
+#include <set>
 
 namespace silkworm::etl {
 
 namespace fs = boost::filesystem;
 
 Collector::~Collector() {
+    if (checkpointed_files_) {
+        // Retain checkpointed files for a later resume and discard the others
+        for (size_t i{0}; i < file_providers_.size(); ++i) {
+            if (file_providers_[i] && i < checkpointed_files_) {
+                file_providers_[i]->close();
+            }
+        }
+        file_providers_.clear();
+        return;
+    }
 
     file_providers_.clear();  // Will ensure all files (if any) have been orderly closed and deleted before we remove
                               // the working dir
@@ -61,8 +72,45 @@ void Collector::collect(Entry& entry) {
     }
 }
 
+void Collector::checkpoint(ByteView cursor) {
+    flush_buffer();
+
+    Manifest manifest{{Bytes(cursor)}, {}};
+    for (const auto& file_provider : file_providers_) {
+        manifest.files.push_back({fs::path(file_provider->get_file_name()).filename().string(),
+                                  file_provider->get_entries_count()});
+    }
+    write_manifest(work_path_, manifest);
+    checkpointed_files_ = file_providers_.size();
+}
+
+std::optional<Bytes> Collector::restore() {
+    if (size_) {
+        throw etl_error("Can't restore a collector holding data");
+    }
+
+    auto manifest{read_manifest(work_path_)};
+    if (!manifest.has_value() || manifest->cursors.size() != 1) {
+        adopt_files(work_path_, Manifest{});  // Nothing usable : clear leftovers
+        return std::nullopt;
+    }
+
+    file_providers_ = adopt_files(work_path_, *manifest);
+    for (const auto& file_provider : file_providers_) {
+        size_ += file_provider->get_entries_count();
+    }
+    checkpointed_files_ = file_providers_.size();
+    return manifest->cursors.front();
+}
+
 void Collector::load(silkworm::lmdb::Table* table, LoadFunc load_func, unsigned int db_flags, uint32_t log_every_percent) {
 
+    // Files are consumed while loading hence checkpoint would be no longer valid
+    if (checkpointed_files_) {
+        remove_manifest(work_path_);
+        checkpointed_files_ = 0;
+    }
+
     const auto overall_size{size()}; // Amount of work
 
     if (!overall_size) {
@@ -70,37 +118,9 @@ void Collector::load(silkworm::lmdb::Table* table, LoadFunc load_func, unsigned
         return;
     }
 
-    const uint32_t progress_step{log_every_percent ? std::min(log_every_percent, 100u) : 100u};
-    const size_t progress_increment_count{overall_size / (100 / progress_step)};
-    size_t dummy_counter{progress_increment_count};
-    uint32_t actual_progress{0};
-
     if (!file_providers_.size()) {
         buffer_.sort();
-        if (load_func) {
-            for (const auto& etl_entry : buffer_.get_entries()) {
-                auto trasformed_etl_entries{load_func(etl_entry)};
-                for (const auto& transformed_etl_entry : trasformed_etl_entries) {
-                    table->put(transformed_etl_entry.key, transformed_etl_entry.value, db_flags);
-                }
-                if (!--dummy_counter) {
-                    actual_progress += progress_step;
-                    dummy_counter = progress_increment_count;
-                    SILKWORM_LOG(LogInfo) << "ETL Load Progress "
-                                          << " << " << actual_progress << "%" << std::endl;
-                }
-            }
-        } else {
-            for (const auto& etl_entry : buffer_.get_entries()) {
-                table->put(etl_entry.key, etl_entry.value, db_flags);
-                if (!--dummy_counter) {
-                    actual_progress += progress_step;
-                    dummy_counter = progress_increment_count;
-                    SILKWORM_LOG(LogInfo) << "ETL Load Progress "
-                                          << " << " << actual_progress << "%" << std::endl;
-                }
-            }
-        }
+        load_entries(buffer_.get_entries(), table, load_func, db_flags, log_every_percent);
         buffer_.clear();
         return;
     }
@@ -108,16 +128,81 @@ void Collector::load(silkworm::lmdb::Table* table, LoadFunc load_func, unsigned
     // Flush not overflown buffer data to file
     flush_buffer();
 
+    load_files(file_providers_, overall_size, table, load_func, db_flags, log_every_percent);
+
+    size_ = 0; // We have consumed all items
+}
+
+// Emits a log line every given percent increment of processed items
+class LoadProgress {
+  public:
+    LoadProgress(size_t overall_size, uint32_t log_every_percent)
+        : progress_step_{log_every_percent ? std::min(log_every_percent, 100u) : 100u},
+          progress_increment_count_{overall_size / (100 / progress_step_)},
+          dummy_counter_{progress_increment_count_} {}
+
+    void step() {
+        if (!--dummy_counter_) {
+            actual_progress_ += progress_step_;
+            dummy_counter_ = progress_increment_count_;
+            SILKWORM_LOG(LogInfo) << "ETL Load Progress "
+                                  << " << " << actual_progress_ << "%" << std::endl;
+        }
+    }
+
+  private:
+    const uint32_t progress_step_;
+    const size_t progress_increment_count_;
+    size_t dummy_counter_;
+    uint32_t actual_progress_{0};
+};
+
+static void put_entry(lmdb::Table* table, LoadFunc load_func, unsigned int db_flags, const Entry& etl_entry) {
+    if (load_func) {
+        for (const auto& transformed_etl_entry : load_func(etl_entry)) {
+            table->put(transformed_etl_entry.key, transformed_etl_entry.value, db_flags);
+        }
+    } else {
+        table->put(etl_entry.key, etl_entry.value, db_flags);
+    }
+}
+
+static void put_entry(lmdb::Table* table, LoadFunc load_func, unsigned int db_flags, const EntryView& etl_entry) {
+    if (load_func) {
+        // Transform needs an owning copy
+        put_entry(table, load_func, db_flags, Entry{Bytes(etl_entry.key), Bytes(etl_entry.value)});
+    } else {
+        table->put(etl_entry.key, etl_entry.value, db_flags);
+    }
+}
+
+void load_entries(const std::vector<Entry>& entries, lmdb::Table* table, LoadFunc load_func,
+                  unsigned int db_flags, uint32_t log_every_percent) {
+    LoadProgress progress(entries.size(), log_every_percent);
+    for (const auto& etl_entry : entries) {
+        put_entry(table, load_func, db_flags, etl_entry);
+        progress.step();
+    }
+}
+
+void load_files(std::vector<std::unique_ptr<FileProvider>>& file_providers, size_t overall_size,
+                lmdb::Table* table, LoadFunc load_func, unsigned int db_flags, uint32_t log_every_percent) {
+    LoadProgress progress(overall_size, log_every_percent);
+
     // Define a priority queue based on smallest available key
-    auto key_comparer = [](std::pair<Entry, int> left, std::pair<Entry, int> right) {
+    // Entries are views over mapped files hence no data is copied while merging
+    auto key_comparer = [](const std::pair<EntryView, int>& left, const std::pair<EntryView, int>& right) {
         return left.first.key.compare(right.first.key) > 0;
     };
-    std::priority_queue<std::pair<Entry, int>, std::vector<std::pair<Entry, int>>, decltype(key_comparer)> queue(
-        key_comparer);
+    std::priority_queue<std::pair<EntryView, int>, std::vector<std::pair<EntryView, int>>, decltype(key_comparer)>
+        queue(key_comparer);
 
     // Read one "record" from each data_provider and let the queue
     // sort them. On top of the queue the smallest key
-    for (auto& file_provider : file_providers_) {
+    for (auto& file_provider : file_providers) {
+        if (!file_provider) {
+            continue;
+        }
         auto item{file_provider->read_entry()};
         if (item.has_value()) {
             queue.push(*item);
@@ -126,25 +211,14 @@ void Collector::load(silkworm::lmdb::Table* table, LoadFunc load_func, unsigned
 
     // Process the queue from smallest to largest key
     while (queue.size()) {
-        auto& [etl_entry, provider_index]{queue.top()};           // Pick smallest key by reference
-        auto& file_provider{file_providers_.at(provider_index)};  // and set current file provider
+        auto& [etl_entry, provider_index]{queue.top()};          // Pick smallest key by reference
+        auto& file_provider{file_providers.at(provider_index)};  // and set current file provider
 
         // Process linked pairs
-        if (load_func) {
-            for (const auto& transformed_etl_entry : load_func(etl_entry)) {
-                table->put(transformed_etl_entry.key, transformed_etl_entry.value, db_flags);
-            }
-        } else {
-            table->put(etl_entry.key, etl_entry.value, db_flags);
-        }
+        put_entry(table, load_func, db_flags, etl_entry);
 
         // Display progress
-        if (!--dummy_counter) {
-            actual_progress += progress_step;
-            dummy_counter = progress_increment_count;
-            SILKWORM_LOG(LogInfo) << "ETL Load Progress "
-                << " << " << actual_progress << "%" << std::endl;
-        }
+        progress.step();
 
         // From the provider which has served the current key
         // read next "record"
@@ -162,11 +236,9 @@ void Collector::load(silkworm::lmdb::Table* table, LoadFunc load_func, unsigned
             file_provider.reset();
         }
     }
-
-    size_ = 0; // We have consumed all items
 }
 
-std::string Collector::set_work_path(const char* provided_work_path) {
+std::string set_work_path(const char* provided_work_path) {
     // If something provided ensure exists as a directory
     if (provided_work_path) {
         fs::path path(provided_work_path);
@@ -184,6 +256,27 @@ std::string Collector::set_work_path(const char* provided_work_path) {
     return p.string();
 }
 
+std::vector<std::unique_ptr<FileProvider>> adopt_files(const std::string& work_path, const Manifest& manifest) {
+    std::set<std::string> recorded;
+    for (const auto& file : manifest.files) {
+        recorded.insert(file.name);
+    }
+    for (fs::directory_iterator it{work_path}, end; it != end; ++it) {
+        const auto& path{it->path()};
+        if (path.extension() == ".bin" && !recorded.count(path.filename().string())) {
+            fs::remove(path);
+        }
+    }
+
+    std::vector<std::unique_ptr<FileProvider>> file_providers;
+    for (const auto& file : manifest.files) {
+        fs::path path{fs::path(work_path) / fs::path(file.name)};
+        file_providers.emplace_back(new FileProvider(path.string(), file_providers.size()));
+        file_providers.back()->reopen(file.entries);
+    }
+    return file_providers;
+}
+
 std::vector<Entry> identity_load(Entry entry) { return std::vector<Entry>({entry}); }
 
 }  // namespace silkworm::etl
@@ -21,6 +21,7 @@
 #include <silkworm/db/chaindb.hpp>
 #include <silkworm/etl/buffer.hpp>
 #include <silkworm/etl/file_provider.hpp>
+#include <silkworm/etl/manifest.hpp>
 #include <silkworm/etl/util.hpp>
 
 // ETL : Extract, Transform, Load
@@ -33,6 +34,17 @@ constexpr size_t kOptimalBufferSize = 256 * kMebi;
 // Function pointer to process Load on before Load data into tables
 typedef std::vector<Entry> (*LoadFunc)(Entry);
 
+// Ensures provided work path exists or creates a unique temporary one
+std::string set_work_path(const char* provided_work_path);
+
+// Loads entries, already sorted in memory, into table
+void load_entries(const std::vector<Entry>& entries, lmdb::Table* table, LoadFunc load_func, unsigned int db_flags,
+                  uint32_t log_every_percent);
+
+// Loads entries into table merging sorted files. Providers are consumed (and files deleted) while reading
+void load_files(std::vector<std::unique_ptr<FileProvider>>& file_providers, size_t overall_size, lmdb::Table* table,
+                LoadFunc load_func, unsigned int db_flags, uint32_t log_every_percent);
+
 // Collects data Extracted from db
 class Collector {
   public:
@@ -51,13 +63,29 @@ class Collector {
      */
     void load(lmdb::Table* table, LoadFunc load_func, unsigned int db_flags = 0, uint32_t log_every_percent = 100u);
 
+    /** @brief Flushes collected entries to disk and persists a manifest of all flushed files
+     * along with the given cursor (i.e. the extraction position reached by the caller)
+     *
+     * Once a checkpoint is taken files are retained on disk, even if the collector is destroyed,
+     * until a load begins.
+     *
+     * @param cursor : Opaque position from which extraction should resume
+     */
+    void checkpoint(ByteView cursor);
+
+    /** @brief Adopts files recorded by a previous checkpoint in work path
+     *
+     * Must be called before any entry is collected. Files not recorded in manifest are removed.
+     *
+     * @return The cursor persisted by last checkpoint or std::nullopt if there's nothing to resume
+     */
+    std::optional<Bytes> restore();
 
     /** @brief Returns the number of actually collected items
      */
     size_t size() const;
 
   private:
-    std::string set_work_path(const char* provided_work_path);
     void flush_buffer();  // Write buffer to file
 
     std::string work_path_;
@@ -78,8 +106,13 @@ class Collector {
 
     std::vector<std::unique_ptr<FileProvider>> file_providers_;
     size_t size_{0};
+    size_t checkpointed_files_{0};  // Number of leading file providers recorded in manifest
 };
 
+// Removes all files in work path not recorded in manifest and returns the
+// file providers of the recorded ones. Throws if any recorded file is missing
+std::vector<std::unique_ptr<FileProvider>> adopt_files(const std::string& work_path, const Manifest& manifest);
+
 // Default no transform function
 std::vector<Entry> identity_load(Entry entry);
 
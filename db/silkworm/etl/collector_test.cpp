@@ -94,4 +94,61 @@ TEST_CASE("collect_and_load") {
     });
 }
 
+TEST_CASE("collect_checkpoint_and_restore") {
+    TemporaryDirectory db_tmp_dir;
+    TemporaryDirectory etl_tmp_dir;
+    lmdb::DatabaseConfig db_config{db_tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+    auto set{generate_entry_set(1000)};
+    const Bytes cursor{0x01, 0x02};
+
+    {
+        // Interrupted run : checkpoint after 450 entries then collect some more
+        Collector collector(etl_tmp_dir.path(), 100 * 16);
+        for (size_t i{0}; i < 450; ++i) {
+            auto entry{set[i]};
+            collector.collect(entry);
+        }
+        collector.checkpoint(cursor);
+        for (size_t i{450}; i < 750; ++i) {
+            auto entry{set[i]};
+            collector.collect(entry);
+        }
+    }
+    CHECK(read_manifest(etl_tmp_dir.path()).has_value());
+
+    // Resumed run : files flushed after the checkpoint are discarded
+    Collector collector(etl_tmp_dir.path(), 100 * 16);
+    auto restored_cursor{collector.restore()};
+    REQUIRE(restored_cursor.has_value());
+    CHECK(*restored_cursor == cursor);
+    CHECK(collector.size() == 450);
+    CHECK(std::distance(fs::directory_iterator{etl_tmp_dir.path()}, fs::directory_iterator{}) == 5 + 1);
+
+    for (size_t i{450}; i < set.size(); ++i) {
+        auto entry{set[i]};
+        collector.collect(entry);
+    }
+    auto to{txn->open(db::table::kHeaderNumbers)};
+    collector.load(to.get(), nullptr);
+
+    size_t rcount{0};
+    lmdb::err_handler(to->get_rcount(&rcount));
+    CHECK(rcount == set.size());
+    for (auto& entry : set) {
+        auto value{to->get(entry.key)};
+        REQUIRE(value);
+        CHECK(value->compare(entry.value) == 0);
+    }
+    CHECK_FALSE(read_manifest(etl_tmp_dir.path()).has_value());
+    CHECK(std::distance(fs::directory_iterator{etl_tmp_dir.path()}, fs::directory_iterator{}) == 0);
+
+    // Nothing left to resume
+    Collector another_collector(etl_tmp_dir.path(), 100 * 16);
+    CHECK_FALSE(another_collector.restore().has_value());
+}
+
 }  // namespace silkworm::etl
@@ -17,6 +17,7 @@
 #include "file_provider.hpp"
 
 #include <boost/filesystem/operations.hpp>
+#include <cstring>
 
 namespace silkworm::etl {
 
@@ -30,6 +31,11 @@ FileProvider::~FileProvider(void) { reset(); }
 void FileProvider::flush(Buffer &buffer) {
     head_t head{};
 
+    // Never overwrite a file : it may belong to a checkpoint being resumed
+    if (fs::exists(file_name_)) {
+        throw etl_error("File already exists " + file_name_);
+    }
+
     // Check we have enough space to store all data
     auto &entries{buffer.get_entries()};
     file_size_ = {buffer.size() + entries.size() * sizeof(head_t)};
@@ -46,6 +52,7 @@ void FileProvider::flush(Buffer &buffer) {
         throw etl_error(strerror(errno));
     };
 
+    entries_count_ = entries.size();
     for (const auto &entry : entries) {
         head.lengths[0] = entry.key.size();
         head.lengths[1] = entry.value.size();
@@ -58,52 +65,94 @@ void FileProvider::flush(Buffer &buffer) {
         }
     }
 
-    // Close file in output mode and reopen for input mode
-    // This is actually not strictly needed but amends an odd behavior on Windows
+    // Close file in output mode and map it for input
+    // Closing also amends an odd behavior on Windows
     // which prevents correct display of file size if the handle
     // has not been closed
     file_.close();
-    file_.open(file_name_, std::ios_base::in | std::ios_base::binary);
-    if (!file_.is_open()) {
-        auto err{errno};
+    map();
+}
+
+void FileProvider::reopen(size_t entries_count) {
+    if (!fs::exists(file_name_)) {
+        throw etl_error("Missing file " + file_name_);
+    }
+    file_size_ = fs::file_size(file_name_);
+    entries_count_ = entries_count;
+    map();
+}
+
+void FileProvider::map() {
+    namespace bip = boost::interprocess;
+    try {
+        file_mapping_ = bip::file_mapping(file_name_.c_str(), bip::read_only);
+        mapped_region_ = bip::mapped_region(file_mapping_, bip::read_only, 0, file_size_);
+    } catch (const bip::interprocess_exception &ex) {
         reset();
-        throw etl_error(strerror(err));
-    };
+        throw etl_error(ex.what());
+    }
+    // Merge reads each file front to back : let the kernel read ahead aggressively
+    // and drop pages behind
+    mapped_region_.advise(bip::mapped_region::advice_sequential);
+    read_offset_ = 0;
 }
 
-std::optional<std::pair<Entry, int>> FileProvider::read_entry() {
+void FileProvider::unmap() {
+    mapped_region_ = boost::interprocess::mapped_region();
+    file_mapping_ = boost::interprocess::file_mapping();
+}
+
+std::optional<std::pair<EntryView, int>> FileProvider::read_entry() {
     head_t head{};
 
-    if (!file_.is_open() || !file_size_) {
+    const auto *data{static_cast<const uint8_t *>(mapped_region_.get_address())};
+    if (!data || !file_size_) {
         throw etl_error("Invalid file handle");
     }
 
-    if (!file_.read((char *)head.bytes, 8)) {
+    if (read_offset_ + sizeof(head_t) > file_size_) {
         reset();
         return std::nullopt;
     }
 
-    Entry entry{Bytes(head.lengths[0], '\0'), Bytes(head.lengths[1], '\0')};
-    if (!file_.read((char *)entry.key.data(), head.lengths[0]) ||
-        !file_.read((char *)entry.value.data(), head.lengths[1])) {
-        auto err{errno};
+    std::memcpy(head.bytes, &data[read_offset_], sizeof(head_t));
+    read_offset_ += sizeof(head_t);
+    if (read_offset_ + head.lengths[0] + head.lengths[1] > file_size_) {
         reset();
-        throw etl_error(strerror(err));
+        throw etl_error("Truncated file");
     }
 
+    EntryView entry{ByteView(&data[read_offset_], head.lengths[0]),
+                    ByteView(&data[read_offset_ + head.lengths[0]], head.lengths[1])};
+    read_offset_ += head.lengths[0] + head.lengths[1];
+
     return std::make_pair(entry, id_);
 }
 
 void FileProvider::reset() {
     file_size_ = 0;
+    bool has_file{file_.is_open() || mapped_region_.get_address()};
     if (file_.is_open()) {
         file_.close();
+    }
+    unmap();
+    if (has_file) {
         fs::remove(file_name_.c_str());
     }
 }
 
+void FileProvider::close() {
+    file_size_ = 0;
+    if (file_.is_open()) {
+        file_.close();
+    }
+    unmap();
+}
+
 std::string FileProvider::get_file_name(void) const { return file_name_; }
 
 size_t FileProvider::get_file_size(void) const { return file_size_; }
 
+size_t FileProvider::get_entries_count(void) const { return entries_count_; }
+
 }  // namespace silkworm::etl
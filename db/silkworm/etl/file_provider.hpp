@@ -18,6 +18,8 @@
 #ifndef ETL_SILKWORM_FILE_PROVIDER_H_
 #define ETL_SILKWORM_FILE_PROVIDER_H_
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <fstream>
 #include <memory>
 #include <optional>
@@ -28,24 +30,41 @@ namespace silkworm::etl {
 
 /**
  * Provides an abstraction to flush data to disk
- * and re-read flushed data sequentially
+ * and re-read flushed data sequentially.
+ * Data is written through a stream and read back through a read-only
+ * memory mapping advised for sequential access, so entries are served
+ * as views over the mapped file without copies.
  */
 class FileProvider {
   public:
     FileProvider(std::string file_name, size_t id);
     ~FileProvider(void);
-    void flush(Buffer& buffer);                         // Write buffer's contents to disk
-    std::optional<std::pair<Entry, int>> read_entry();  // Read next data element from file starting from position 0
-    void reset();                                       // Remove the file when eof is met
+    void flush(Buffer& buffer);         // Write buffer's contents to disk (throws if file already exists)
+    void reopen(size_t entries_count);  // Reopen for reading a file flushed by a previous run
+
+    // Read next data element from file starting from position 0
+    // Returned views are valid until the file is reset (i.e. eof is met) or closed
+    std::optional<std::pair<EntryView, int>> read_entry();
+
+    void reset();  // Remove the file when eof is met
+    void close();  // Close the file keeping it on disk
 
     std::string get_file_name(void) const;
     size_t get_file_size(void) const;
+    size_t get_entries_count(void) const;
 
   private:
+    void map();    // Map written file for reading
+    void unmap();  // Release the mapping (if any)
+
     size_t id_;
-    std::fstream file_;      // Actual file stream
-    std::string file_name_;  // Actual name of file
-    size_t file_size_{0};    // Actual size of written data
+    std::fstream file_;                                      // Actual file stream (write phase)
+    boost::interprocess::file_mapping file_mapping_;         // Actual file mapping (read phase)
+    boost::interprocess::mapped_region mapped_region_;       // Mapped view of whole file
+    std::string file_name_;                                  // Actual name of file
+    size_t file_size_{0};                                    // Actual size of written data
+    size_t entries_count_{0};                                // Number of entries in file
+    size_t read_offset_{0};                                  // Position of next entry in mapped file
 };
 }  // namespace silkworm::etl
 #endif  // !ETL_SILKWORM_FILE_PROVIDER_H_
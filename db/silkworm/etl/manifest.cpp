@@ -0,0 +1,142 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "manifest.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <silkworm/etl/util.hpp>
+
+namespace silkworm::etl {
+
+namespace fs = boost::filesystem;
+
+static constexpr const char* kManifestFileName{"manifest"};
+static constexpr uint32_t kManifestMagic{0x45544c4d};  // "ETLM"
+
+static void append_u32(Bytes& out, uint32_t value) {
+    uint8_t buf[4];
+    boost::endian::store_big_u32(buf, value);
+    out.append(buf, 4);
+}
+
+static void append_u64(Bytes& out, uint64_t value) {
+    uint8_t buf[8];
+    boost::endian::store_big_u64(buf, value);
+    out.append(buf, 8);
+}
+
+static bool read_u32(ByteView& in, uint32_t& value) {
+    if (in.length() < 4) {
+        return false;
+    }
+    value = boost::endian::load_big_u32(in.data());
+    in.remove_prefix(4);
+    return true;
+}
+
+static bool read_u64(ByteView& in, uint64_t& value) {
+    if (in.length() < 8) {
+        return false;
+    }
+    value = boost::endian::load_big_u64(in.data());
+    in.remove_prefix(8);
+    return true;
+}
+
+static bool read_bytes(ByteView& in, Bytes& value) {
+    uint32_t length{0};
+    if (!read_u32(in, length) || in.length() < length) {
+        return false;
+    }
+    value.assign(in.data(), length);
+    in.remove_prefix(length);
+    return true;
+}
+
+void write_manifest(const std::string& work_path, const Manifest& manifest) {
+    Bytes data;
+    append_u32(data, kManifestMagic);
+    append_u32(data, static_cast<uint32_t>(manifest.cursors.size()));
+    for (const auto& cursor : manifest.cursors) {
+        append_u32(data, static_cast<uint32_t>(cursor.length()));
+        data.append(cursor);
+    }
+    append_u32(data, static_cast<uint32_t>(manifest.files.size()));
+    for (const auto& file : manifest.files) {
+        append_u32(data, static_cast<uint32_t>(file.name.length()));
+        data.append(reinterpret_cast<const uint8_t*>(file.name.data()), file.name.length());
+        append_u64(data, file.entries);
+    }
+
+    // Write aside and rename so a crash never leaves a partially written manifest
+    fs::path path{fs::path(work_path) / fs::path(kManifestFileName)};
+    fs::path tmp_path{path.string() + ".tmp"};
+    std::ofstream file(tmp_path.string(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open() || !file.write(reinterpret_cast<const char*>(data.data()), data.length())) {
+        throw etl_error("Unable to write manifest " + tmp_path.string());
+    }
+    file.close();
+    fs::rename(tmp_path, path);
+}
+
+std::optional<Manifest> read_manifest(const std::string& work_path) {
+    fs::path path{fs::path(work_path) / fs::path(kManifestFileName)};
+    if (!fs::exists(path)) {
+        return std::nullopt;
+    }
+
+    std::ifstream file(path.string(), std::ios_base::in | std::ios_base::binary);
+    std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    ByteView in{reinterpret_cast<const uint8_t*>(content.data()), content.length()};
+
+    Manifest manifest{};
+    uint32_t magic{0}, count{0};
+    if (!read_u32(in, magic) || magic != kManifestMagic || !read_u32(in, count)) {
+        return std::nullopt;
+    }
+    manifest.cursors.resize(count);
+    for (auto& cursor : manifest.cursors) {
+        if (!read_bytes(in, cursor)) {
+            return std::nullopt;
+        }
+    }
+    if (!read_u32(in, count)) {
+        return std::nullopt;
+    }
+    manifest.files.resize(count);
+    for (auto& file_entry : manifest.files) {
+        Bytes name;
+        uint64_t entries{0};
+        if (!read_bytes(in, name) || !read_u64(in, entries)) {
+            return std::nullopt;
+        }
+        file_entry.name.assign(reinterpret_cast<const char*>(name.data()), name.length());
+        file_entry.entries = entries;
+    }
+    if (!in.empty()) {
+        return std::nullopt;
+    }
+    return manifest;
+}
+
+void remove_manifest(const std::string& work_path) {
+    fs::remove(fs::path(work_path) / fs::path(kManifestFileName));
+}
+
+}  // namespace silkworm::etl
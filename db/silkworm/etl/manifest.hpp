@@ -0,0 +1,54 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#ifndef SILKWORM_ETL_MANIFEST_H_
+#define SILKWORM_ETL_MANIFEST_H_
+
+#include <optional>
+#include <silkworm/common/base.hpp>
+#include <string>
+#include <vector>
+
+namespace silkworm::etl {
+
+/*
+ * Checkpoint of a collector persisted in its work path.
+ * Records the sorted files already flushed to disk together with the extraction
+ * position (cursor) each shard had reached when those files were flushed,
+ * so an interrupted stage can reuse them and only extract the remaining data.
+ */
+struct Manifest {
+    struct File {
+        std::string name;  // File name relative to work path
+        size_t entries;    // Number of entries in file
+    };
+
+    std::vector<Bytes> cursors;  // One opaque cursor per shard (empty if shard never checkpointed)
+    std::vector<File> files;     // Sorted files covered by cursors
+};
+
+// Atomically (over)writes the manifest in work path
+void write_manifest(const std::string& work_path, const Manifest& manifest);
+
+// Reads the manifest from work path. Returns std::nullopt if none or unreadable
+std::optional<Manifest> read_manifest(const std::string& work_path);
+
+// Removes the manifest from work path (if any)
+void remove_manifest(const std::string& work_path);
+
+}  // namespace silkworm::etl
+#endif  // !SILKWORM_ETL_MANIFEST_H_
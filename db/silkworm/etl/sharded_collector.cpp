@@ -0,0 +1,213 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sharded_collector.hpp"
+
+#include <boost/filesystem.hpp>
+#include <cstdlib>
+#include <silkworm/common/log.hpp>
+
+namespace silkworm::etl {
+
+namespace fs = boost::filesystem;
+
+// Returns the sequence number of a file named <unique_id>-<seq>.bin (or 0 for any other name)
+static size_t parse_file_seq(const std::string& file_name) {
+    auto dash{file_name.rfind('-')};
+    if (dash == std::string::npos) {
+        return 0;
+    }
+    char* end{nullptr};
+    auto seq{std::strtoull(file_name.c_str() + dash + 1, &end, 10)};
+    return std::string(end) == ".bin" ? seq : 0;
+}
+
+ShardedCollector::ShardedCollector(size_t num_shards, const char* work_path, size_t optimal_size)
+    : work_path_{set_work_path(work_path)}, cursors_(std::max<size_t>(num_shards, 1)) {
+    for (size_t i{0}; i < cursors_.size(); ++i) {
+        shards_.emplace_back(new Shard(optimal_size / cursors_.size()));
+    }
+}
+
+ShardedCollector::~ShardedCollector() {
+    if (checkpointed_) {
+        // Retain checkpointed files for a later resume and discard the others
+        for (size_t i{0}; i < file_providers_.size(); ++i) {
+            if (file_providers_[i] && file_committed_[i]) {
+                file_providers_[i]->close();
+            }
+        }
+        file_providers_.clear();
+        return;
+    }
+
+    file_providers_.clear();  // Will ensure all files (if any) have been orderly closed and deleted before we remove
+                              // the working dir
+    fs::path path(work_path_);
+    if (fs::exists(path)) {
+        fs::remove_all(path);
+    }
+}
+
+void ShardedCollector::flush_buffer(size_t shard) {
+    Buffer& buffer{shards_.at(shard)->buffer};
+    if (!buffer.size()) {
+        return;
+    }
+
+    buffer.sort();
+
+    // Reserve a slot so the provider id matches its position in file_providers_
+    // and write the file without holding the lock
+    size_t id{0};
+    size_t seq{0};
+    {
+        std::unique_lock l{file_providers_mtx_};
+        id = file_providers_.size();
+        seq = next_file_seq_++;
+        file_providers_.emplace_back(nullptr);
+        file_shards_.push_back(shard);
+        file_committed_.push_back(false);
+    }
+
+    fs::path new_file_path{fs::path(work_path_) /
+                           fs::path(std::to_string(unique_id_) + "-" + std::to_string(seq) + ".bin")};
+    std::unique_ptr<FileProvider> file_provider{new FileProvider(new_file_path.string(), id)};
+    file_provider->flush(buffer);
+    buffer.clear();
+
+    std::unique_lock l{file_providers_mtx_};
+    file_providers_[id] = std::move(file_provider);
+}
+
+size_t ShardedCollector::size() const {
+    size_t ret{restored_size_};
+    for (const auto& shard : shards_) {
+        ret += shard->size.load(std::memory_order_relaxed);
+    }
+    return ret;
+}
+
+void ShardedCollector::collect(size_t shard, Entry& entry) {
+    Shard& s{*shards_.at(shard)};
+    s.buffer.put(entry);
+    // Only the owning producer writes the counter : no need for an atomic read-modify-write
+    s.size.store(s.size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (s.buffer.overflows()) {
+        flush_buffer(shard);
+    }
+}
+
+void ShardedCollector::checkpoint(size_t shard, ByteView cursor) {
+    flush_buffer(shard);
+
+    std::unique_lock l{file_providers_mtx_};
+    for (size_t i{0}; i < file_providers_.size(); ++i) {
+        if (file_shards_[i] == shard) {
+            file_committed_[i] = true;
+        }
+    }
+    cursors_[shard] = Bytes(cursor);
+
+    Manifest manifest{cursors_, {}};
+    for (size_t i{0}; i < file_providers_.size(); ++i) {
+        if (file_committed_[i]) {
+            manifest.files.push_back({fs::path(file_providers_[i]->get_file_name()).filename().string(),
+                                      file_providers_[i]->get_entries_count()});
+        }
+    }
+    write_manifest(work_path_, manifest);
+    checkpointed_ = true;
+}
+
+std::optional<std::vector<Bytes>> ShardedCollector::restore() {
+    if (size()) {
+        throw etl_error("Can't restore a collector holding data");
+    }
+
+    auto manifest{read_manifest(work_path_)};
+    if (!manifest.has_value() || manifest->cursors.size() != shards_.size()) {
+        adopt_files(work_path_, Manifest{});  // Nothing usable : clear leftovers
+        return std::nullopt;
+    }
+
+    std::unique_lock l{file_providers_mtx_};
+    file_providers_ = adopt_files(work_path_, *manifest);
+    file_shards_.assign(file_providers_.size(), SIZE_MAX);  // Adopted files belong to no live shard
+    file_committed_.assign(file_providers_.size(), true);
+    for (const auto& file_provider : file_providers_) {
+        restored_size_ += file_provider->get_entries_count();
+    }
+    // Adopted files need not be a prefix of the interrupted run's sequence (shards checkpoint
+    // independently) : number new files above the highest adopted one
+    for (const auto& file : manifest->files) {
+        next_file_seq_ = std::max(next_file_seq_, parse_file_seq(file.name) + 1);
+    }
+    cursors_ = manifest->cursors;
+    checkpointed_ = true;
+    return cursors_;
+}
+
+void ShardedCollector::load(lmdb::Table* table, LoadFunc load_func, unsigned int db_flags,
+                            uint32_t log_every_percent) {
+    // Files are consumed while loading hence checkpoint would be no longer valid
+    if (checkpointed_) {
+        remove_manifest(work_path_);
+        checkpointed_ = false;
+    }
+
+    const auto overall_size{size()};  // Amount of work
+
+    if (!overall_size) {
+        SILKWORM_LOG(LogInfo) << "ETL Load called without data to process" << std::endl;
+        return;
+    }
+
+    if (file_providers_.empty()) {
+        // Nothing has been spilled : gather all shards into the first one
+        // and load from memory
+        Buffer& buffer{shards_.front()->buffer};
+        for (size_t i{1}; i < shards_.size(); ++i) {
+            for (auto& entry : shards_[i]->buffer.get_entries()) {
+                buffer.put(entry);
+            }
+            shards_[i]->buffer.clear();
+        }
+        buffer.sort();
+        load_entries(buffer.get_entries(), table, load_func, db_flags, log_every_percent);
+        buffer.clear();
+        reset_size();
+        return;
+    }
+
+    // Flush not overflown shards data to files
+    for (size_t shard{0}; shard < shards_.size(); ++shard) {
+        flush_buffer(shard);
+    }
+
+    load_files(file_providers_, overall_size, table, load_func, db_flags, log_every_percent);
+
+    reset_size();  // We have consumed all items
+}
+
+void ShardedCollector::reset_size() {
+    restored_size_ = 0;
+    for (auto& shard : shards_) {
+        shard->size = 0;
+    }
+}
+
+}  // namespace silkworm::etl
@@ -0,0 +1,113 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+#ifndef SILKWORM_ETL_SHARDED_COLLECTOR_H_
+#define SILKWORM_ETL_SHARDED_COLLECTOR_H_
+
+#include <atomic>
+#include <mutex>
+#include <silkworm/etl/collector.hpp>
+
+namespace silkworm::etl {
+
+constexpr size_t kCacheLineSize{64};
+
+/*
+ * Same as Collector but accepts entries from many concurrent producers.
+ * Each producer owns a shard (i.e. a buffer) which is sorted and flushed
+ * to disk independently of the others when it overflows.
+ * Files from all shards are eventually merged in a single load.
+ */
+class ShardedCollector {
+  public:
+    // Note ! optimal_size is the overall memory budget which is evenly split among shards
+    ShardedCollector(size_t num_shards, const char* work_path = nullptr, size_t optimal_size = kOptimalBufferSize);
+    ~ShardedCollector();
+
+    ShardedCollector(const ShardedCollector&) = delete;
+    ShardedCollector& operator=(const ShardedCollector&) = delete;
+
+    /** @brief Store key-value pair in memory or on disk
+     *
+     * May be called concurrently from different threads provided each thread
+     * uses its own shard. Calls for the same shard must not overlap.
+     */
+    void collect(size_t shard, Entry& entry);
+
+    /** @brief Loads and optionally transforms collected entries from all shards into db
+     *
+     * Must not be called while producers are still collecting.
+     * See Collector::load for the meaning of arguments
+     */
+    void load(lmdb::Table* table, LoadFunc load_func, unsigned int db_flags = 0, uint32_t log_every_percent = 100u);
+
+    /** @brief Flushes shard's entries to disk and persists the manifest with the given cursor for the shard
+     *
+     * Files flushed by a shard are recorded in manifest only when that shard checkpoints, so each
+     * shard can resume from its own cursor. May be called concurrently by producers (each for its own shard).
+     * See Collector::checkpoint
+     */
+    void checkpoint(size_t shard, ByteView cursor);
+
+    /** @brief Adopts files recorded by a previous checkpoint in work path
+     *
+     * Must be called before any entry is collected. A manifest recorded with a different
+     * number of shards is discarded.
+     *
+     * @return The cursors (one per shard) persisted by last checkpoints or std::nullopt if there's nothing to resume
+     */
+    std::optional<std::vector<Bytes>> restore();
+
+    /** @brief Returns the number of actually collected items
+     */
+    size_t size() const;
+
+    size_t num_shards() const { return shards_.size(); }
+
+  private:
+    // State owned by a single producer. Each shard is allocated on its own
+    // cache line(s) so producers never write to memory shared with each other
+    struct alignas(kCacheLineSize) Shard {
+        explicit Shard(size_t optimal_size) : buffer(optimal_size) {}
+        Buffer buffer;
+        std::atomic<size_t> size{0};  // Entries collected by this shard (written by its producer only)
+    };
+
+    void flush_buffer(size_t shard);  // Write shard's buffer to file
+    void reset_size();                // Zero all counters once entries are consumed
+
+    std::string work_path_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    // See Collector::unique_id_
+    uintptr_t unique_id_{reinterpret_cast<uintptr_t>(this)};
+
+    // Sequence number of next flushed file. After restore it's above those of all adopted files
+    // so a collector which happens to get the same unique_id_ as the interrupted run can't reuse their names
+    size_t next_file_seq_{0};
+
+    std::mutex file_providers_mtx_;  // Guards file_providers_ and checkpoint state as shards may flush concurrently
+    std::vector<std::unique_ptr<FileProvider>> file_providers_;
+    std::vector<size_t> file_shards_;   // Shard which flushed each file
+    std::vector<bool> file_committed_;  // Whether each file is recorded in manifest
+    std::vector<Bytes> cursors_;        // Last checkpointed cursor of each shard
+    bool checkpointed_{false};
+    size_t restored_size_{0};  // Entries in files adopted from a previous run
+};
+
+}  // namespace silkworm::etl
+#endif  // !SILKWORM_ETL_SHARDED_COLLECTOR_H_
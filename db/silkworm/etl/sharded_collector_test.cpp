@@ -0,0 +1,221 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sharded_collector.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <catch2/catch.hpp>
+#include <optional>
+#include <silkworm/common/temp_dir.hpp>
+#include <silkworm/db/tables.hpp>
+#include <thread>
+
+namespace silkworm::etl {
+
+namespace fs = boost::filesystem;
+
+// Each producer emits a disjoint set of (sequential) keys
+static Entry make_entry(uint64_t n) {
+    Bytes key(8, '\0');
+    Bytes value(8, '\0');
+    boost::endian::store_big_u64(&key[0], n);
+    boost::endian::store_big_u64(&value[0], ~n);
+    return {key, value};
+}
+
+static void run_sharded_collector_test(size_t optimal_size, bool expect_files) {
+    TemporaryDirectory db_tmp_dir;
+    TemporaryDirectory etl_tmp_dir;
+    lmdb::DatabaseConfig db_config{db_tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    constexpr size_t kNumProducers{4};
+    constexpr uint64_t kEntriesPerProducer{250};
+    ShardedCollector collector(kNumProducers, etl_tmp_dir.path(), optimal_size);
+
+    // Collection
+    std::vector<std::thread> producers;
+    for (size_t shard{0}; shard < kNumProducers; ++shard) {
+        producers.emplace_back([&collector, shard]() {
+            for (uint64_t i{0}; i < kEntriesPerProducer; ++i) {
+                auto entry{make_entry(i * kNumProducers + shard)};
+                collector.collect(shard, entry);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    REQUIRE(collector.size() == kNumProducers * kEntriesPerProducer);
+
+    // Check whether temporary files were generated
+    bool has_files{fs::directory_iterator{etl_tmp_dir.path()} != fs::directory_iterator{}};
+    CHECK(has_files == expect_files);
+
+    // Load data with MDB_APPEND which fails unless keys come sorted across all shards
+    auto to{txn->open(db::table::kHeaderNumbers)};
+    collector.load(to.get(), nullptr, MDB_APPEND);
+    CHECK(collector.size() == 0);
+
+    size_t rcount{0};
+    lmdb::err_handler(to->get_rcount(&rcount));
+    CHECK(rcount == kNumProducers * kEntriesPerProducer);
+    for (uint64_t n{0}; n < kNumProducers * kEntriesPerProducer; ++n) {
+        auto entry{make_entry(n)};
+        auto value{to->get(entry.key)};
+        REQUIRE(value);
+        CHECK(value->compare(entry.value) == 0);
+    }
+
+    // Check whether temporary files were cleaned
+    CHECK(fs::directory_iterator{etl_tmp_dir.path()} == fs::directory_iterator{});
+}
+
+TEST_CASE("sharded_collect_in_memory") { run_sharded_collector_test(kOptimalBufferSize, /*expect_files=*/false); }
+
+TEST_CASE("sharded_collect_and_merge_files") {
+    // 4 shards x 25 entries per file (16 bytes per entry)
+    run_sharded_collector_test(4 * 25 * 16, /*expect_files=*/true);
+}
+
+TEST_CASE("sharded_collect_checkpoint_and_restore") {
+    TemporaryDirectory db_tmp_dir;
+    TemporaryDirectory etl_tmp_dir;
+    lmdb::DatabaseConfig db_config{db_tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    constexpr size_t kNumShards{2};
+    constexpr uint64_t kEntries{1000};
+    constexpr size_t kOptimalSize{kNumShards * 50 * 16};  // 50 entries per file (16 bytes per entry)
+
+    {
+        // Interrupted run : shard 0 checkpoints at 300 entries, shard 1 at 100
+        // then both collect some more which must be discarded
+        ShardedCollector collector(kNumShards, etl_tmp_dir.path(), kOptimalSize);
+        for (uint64_t n{0}; n < 300; ++n) {
+            auto entry{make_entry(n)};
+            collector.collect(0, entry);
+        }
+        for (uint64_t n{500}; n < 600; ++n) {
+            auto entry{make_entry(n)};
+            collector.collect(1, entry);
+        }
+        collector.checkpoint(0, Bytes{0x00});
+        collector.checkpoint(1, Bytes{0x01});
+        for (uint64_t n{300}; n < 420; ++n) {
+            auto entry{make_entry(n)};
+            collector.collect(0, entry);
+        }
+        for (uint64_t n{600}; n < 777; ++n) {
+            auto entry{make_entry(n)};
+            collector.collect(1, entry);
+        }
+    }
+
+    auto manifest{read_manifest(etl_tmp_dir.path())};
+    REQUIRE(manifest.has_value());
+    CHECK(manifest->cursors.size() == kNumShards);
+
+    ShardedCollector collector(kNumShards, etl_tmp_dir.path(), kOptimalSize);
+    auto cursors{collector.restore()};
+    REQUIRE(cursors.has_value());
+    CHECK((*cursors)[0] == Bytes{0x00});
+    CHECK((*cursors)[1] == Bytes{0x01});
+    CHECK(collector.size() == 400);
+
+    for (uint64_t n{300}; n < 500; ++n) {
+        auto entry{make_entry(n)};
+        collector.collect(0, entry);
+    }
+    for (uint64_t n{600}; n < kEntries; ++n) {
+        auto entry{make_entry(n)};
+        collector.collect(1, entry);
+    }
+
+    auto to{txn->open(db::table::kHeaderNumbers)};
+    collector.load(to.get(), nullptr, MDB_APPEND);
+
+    size_t rcount{0};
+    lmdb::err_handler(to->get_rcount(&rcount));
+    CHECK(rcount == kEntries);
+    for (uint64_t n{0}; n < kEntries; ++n) {
+        auto entry{make_entry(n)};
+        auto value{to->get(entry.key)};
+        REQUIRE(value);
+        CHECK(value->compare(entry.value) == 0);
+    }
+    CHECK_FALSE(read_manifest(etl_tmp_dir.path()).has_value());
+}
+
+TEST_CASE("sharded_restore_does_not_overwrite_adopted_files") {
+    TemporaryDirectory db_tmp_dir;
+    TemporaryDirectory etl_tmp_dir;
+    lmdb::DatabaseConfig db_config{db_tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    constexpr size_t kNumShards{2};
+    constexpr size_t kOptimalSize{kNumShards * 50 * 16};  // 50 entries per file (16 bytes per entry)
+
+    // Both runs share the same storage hence the same address (i.e. the same unique id in file names)
+    std::optional<ShardedCollector> collector;
+
+    // Interrupted run : shard 1 flushes a file which is never checkpointed, then shard 0 flushes
+    // the only checkpointed one, so the committed files are not a prefix of the flushed ones
+    collector.emplace(kNumShards, etl_tmp_dir.path(), kOptimalSize);
+    for (uint64_t n{500}; n < 550; ++n) {
+        auto entry{make_entry(n)};
+        collector->collect(1, entry);
+    }
+    for (uint64_t n{0}; n < 50; ++n) {
+        auto entry{make_entry(n)};
+        collector->collect(0, entry);
+    }
+    collector->checkpoint(0, Bytes{0x00});
+    collector.reset();
+
+    collector.emplace(kNumShards, etl_tmp_dir.path(), kOptimalSize);
+    REQUIRE(collector->restore().has_value());
+    CHECK(collector->size() == 50);
+    for (uint64_t n{500}; n < 600; ++n) {
+        auto entry{make_entry(n)};
+        collector->collect(1, entry);
+    }
+
+    auto to{txn->open(db::table::kHeaderNumbers)};
+    collector->load(to.get(), nullptr, MDB_APPEND);
+
+    size_t rcount{0};
+    lmdb::err_handler(to->get_rcount(&rcount));
+    CHECK(rcount == 150);
+    for (uint64_t n : {0u, 49u, 500u, 599u}) {
+        auto entry{make_entry(n)};
+        auto value{to->get(entry.key)};
+        REQUIRE(value);
+        CHECK(value->compare(entry.value) == 0);
+    }
+}
+
+}  // namespace silkworm::etl
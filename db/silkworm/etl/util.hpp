@@ -40,5 +40,11 @@ struct Entry {
     size_t size() const noexcept { return key.size() + value.size(); }
 };
 
+// A non owning view of a data chunk (e.g. on a memory mapped file)
+struct EntryView {
+    ByteView key;
+    ByteView value;
+};
+
 }  // namespace silkworm::etl
 #endif  // !SILKWORM_ETL_UTIL_H_
@@ -0,0 +1,522 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "intermediate_hashes.hpp"
+
+#include <algorithm>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/access_layer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace silkworm::trie {
+
+static constexpr size_t kHashedStoragePrefixLength{kHashLength + db::kIncarnationLength};
+
+// Account trie paths as long as a hashed storage prefix would be indistinguishable from it in kIntermediateTrieHash
+static constexpr size_t kMaxAccountPathLength{kHashedStoragePrefixLength - 1};
+
+Bytes hashed_storage_prefix(const evmc::bytes32& hashed_address, uint64_t incarnation) {
+    Bytes res(kHashedStoragePrefixLength, '\0');
+    std::memcpy(&res[0], hashed_address.bytes, kHashLength);
+    boost::endian::store_big_u64(&res[kHashLength], incarnation);
+    return res;
+}
+
+void IntermediateHashUpdates::put(ByteView storage_prefix, ByteView path, const evmc::bytes32& hash) {
+    if (storage_prefix.empty() && (path.empty() || path.length() > kMaxAccountPathLength)) {
+        return;
+    }
+    entries_[{Bytes{storage_prefix}, Bytes{path}}] = hash;
+}
+
+void IntermediateHashUpdates::erase(ByteView storage_prefix, ByteView path) {
+    entries_[{Bytes{storage_prefix}, Bytes{path}}] = std::nullopt;
+}
+
+// Positions the cursor on the given storage trie entry, if any
+static bool seek_storage_entry(lmdb::Table& table, ByteView storage_prefix, ByteView path) {
+    // The table compares dups excluding the trailing hash
+    Bytes sub_key{path};
+    sub_key.resize(path.length() + kHashLength);
+    MDB_val key{db::to_mdb_val(storage_prefix)};
+    MDB_val data{db::to_mdb_val(sub_key)};
+    int rc{table.seek_dup(&key, &data)};
+    if (rc == MDB_NOTFOUND) {
+        return false;
+    }
+    lmdb::err_handler(rc);
+    return data.mv_size == path.length() + kHashLength && std::memcmp(data.mv_data, path.data(), path.length()) == 0;
+}
+
+void IntermediateHashUpdates::write_to_db(lmdb::Transaction& txn) const {
+    auto table{txn.open(db::table::kIntermediateTrieHash)};
+    Bytes data;
+    for (const auto& [key, hash] : entries_) {
+        const auto& [storage_prefix, path]{key};
+        if (storage_prefix.empty()) {
+            table->del(path);
+            if (hash) {
+                table->put(path, full_view(*hash));
+            }
+        } else {
+            if (seek_storage_entry(*table, storage_prefix, path)) {
+                lmdb::err_handler(table->del_current());
+            }
+            if (hash) {
+                data = path;
+                data.append(full_view(*hash));
+                table->put(storage_prefix, data);
+            }
+        }
+    }
+}
+
+namespace {
+
+    // Sources of a single trie : its leaves in kCurrentState and its branch nodes in kIntermediateTrieHash
+    class TrieSource {
+      public:
+        virtual ~TrieSource() = default;
+
+        // First recorded branch node with path >= given path
+        virtual std::optional<std::pair<Bytes, evmc::bytes32>> seek_branch(ByteView path) = 0;
+        virtual std::optional<std::pair<Bytes, evmc::bytes32>> next_branch() = 0;
+
+        // First leaf with key >= given key : (key, value as stored)
+        virtual std::optional<std::pair<Bytes, Bytes>> seek_leaf(ByteView key) = 0;
+        virtual std::optional<std::pair<Bytes, Bytes>> next_leaf() = 0;
+
+        // Value of the leaf to feed HashBuilder with
+        virtual Bytes leaf_value(ByteView key, ByteView stored_value) = 0;
+    };
+
+    class AccountTrieSource : public TrieSource {
+      public:
+        using StorageRootFunc = std::function<evmc::bytes32(const evmc::bytes32& hashed_address, uint64_t incarnation)>;
+
+        AccountTrieSource(lmdb::Transaction& txn, StorageRootFunc storage_root)
+            : state_{txn.open(db::table::kCurrentState)},
+              hashes_{txn.open(db::table::kIntermediateTrieHash)},
+              storage_root_{std::move(storage_root)} {}
+
+        std::optional<std::pair<Bytes, evmc::bytes32>> seek_branch(ByteView path) override {
+            MDB_val key{db::to_mdb_val(path)};
+            MDB_val data;
+            int rc{path.empty() ? hashes_->get_first(&key, &data) : hashes_->seek(&key, &data)};
+            return branch(rc, key, data);
+        }
+
+        std::optional<std::pair<Bytes, evmc::bytes32>> next_branch() override {
+            MDB_val key, data;
+            return branch(hashes_->get_next_nodup(&key, &data), key, data);
+        }
+
+        std::optional<std::pair<Bytes, Bytes>> seek_leaf(ByteView key) override {
+            MDB_val k{db::to_mdb_val(key)};
+            MDB_val data;
+            return leaf(state_->seek(&k, &data), k, data);
+        }
+
+        std::optional<std::pair<Bytes, Bytes>> next_leaf() override {
+            MDB_val key, data;
+            return leaf(state_->get_next_nodup(&key, &data), key, data);
+        }
+
+        Bytes leaf_value(ByteView key, ByteView stored_value) override {
+            auto [account, err]{decode_account_from_storage(stored_value)};
+            if (err != rlp::DecodingResult::kOk) {
+                throw err;
+            }
+            account.storage_root = storage_root_(to_bytes32(key), account.incarnation);
+            Bytes rlp;
+            rlp::encode(rlp, account);
+            return rlp;
+        }
+
+      private:
+        // Skips storage entries
+        std::optional<std::pair<Bytes, evmc::bytes32>> branch(int rc, MDB_val& key, MDB_val& data) {
+            while (!rc && key.mv_size > kMaxAccountPathLength) {
+                rc = hashes_->get_next_nodup(&key, &data);
+            }
+            if (rc == MDB_NOTFOUND) {
+                return std::nullopt;
+            }
+            lmdb::err_handler(rc);
+            return std::pair{Bytes{db::from_mdb_val(key)}, to_bytes32(db::from_mdb_val(data))};
+        }
+
+        // Skips storage entries
+        std::optional<std::pair<Bytes, Bytes>> leaf(int rc, MDB_val& key, MDB_val& data) {
+            while (!rc && key.mv_size != kHashLength) {
+                rc = state_->get_next_nodup(&key, &data);
+            }
+            if (rc == MDB_NOTFOUND) {
+                return std::nullopt;
+            }
+            lmdb::err_handler(rc);
+            return std::pair{Bytes{db::from_mdb_val(key)}, Bytes{db::from_mdb_val(data)}};
+        }
+
+        std::unique_ptr<lmdb::Table> state_;
+        std::unique_ptr<lmdb::Table> hashes_;
+        StorageRootFunc storage_root_;
+    };
+
+    class StorageTrieSource : public TrieSource {
+      public:
+        StorageTrieSource(lmdb::Table& state, lmdb::Table& hashes, ByteView storage_prefix)
+            : state_{state}, hashes_{hashes}, storage_prefix_{storage_prefix} {}
+
+        std::optional<std::pair<Bytes, evmc::bytes32>> seek_branch(ByteView path) override {
+            Bytes sub_key{path};
+            sub_key.resize(path.length() + kHashLength);
+            MDB_val key{db::to_mdb_val(storage_prefix_)};
+            MDB_val data{db::to_mdb_val(sub_key)};
+            return branch(hashes_.seek_dup(&key, &data), key, data);
+        }
+
+        std::optional<std::pair<Bytes, evmc::bytes32>> next_branch() override {
+            MDB_val key, data;
+            return branch(hashes_.get_next_dup(&key, &data), key, data);
+        }
+
+        std::optional<std::pair<Bytes, Bytes>> seek_leaf(ByteView key) override {
+            MDB_val k{db::to_mdb_val(storage_prefix_)};
+            MDB_val data{db::to_mdb_val(key)};
+            return leaf(state_.seek_dup(&k, &data), data);
+        }
+
+        std::optional<std::pair<Bytes, Bytes>> next_leaf() override {
+            MDB_val key, data;
+            return leaf(state_.get_next_dup(&key, &data), data);
+        }
+
+        Bytes leaf_value(ByteView, ByteView stored_value) override {
+            Bytes rlp;
+            rlp::encode(rlp, stored_value);
+            return rlp;
+        }
+
+      private:
+        // Skips the storage root
+        std::optional<std::pair<Bytes, evmc::bytes32>> branch(int rc, MDB_val& key, MDB_val& data) {
+            while (!rc && data.mv_size == kHashLength) {
+                rc = hashes_.get_next_dup(&key, &data);
+            }
+            if (rc == MDB_NOTFOUND) {
+                return std::nullopt;
+            }
+            lmdb::err_handler(rc);
+            ByteView value{db::from_mdb_val(data)};
+            return std::pair{Bytes{value.substr(0, value.length() - kHashLength)},
+                             to_bytes32(value.substr(value.length() - kHashLength))};
+        }
+
+        std::optional<std::pair<Bytes, Bytes>> leaf(int rc, MDB_val& data) {
+            if (rc == MDB_NOTFOUND) {
+                return std::nullopt;
+            }
+            lmdb::err_handler(rc);
+            ByteView value{db::from_mdb_val(data)};
+            return std::pair{Bytes{value.substr(0, kHashLength)}, Bytes{value.substr(kHashLength)}};
+        }
+
+        lmdb::Table& state_;
+        lmdb::Table& hashes_;
+        ByteView storage_prefix_;
+    };
+
+    // Collects the RLP of the nodes lying on the paths to some keys of a trie
+    class ProofCollector {
+      public:
+        explicit ProofCollector(const std::vector<Bytes>& keys) : nodes_(keys.size()) {
+            for (const auto& key : keys) {
+                paths_.push_back(unpack_nibbles(key));
+            }
+        }
+
+        const std::vector<Bytes>& paths() const { return paths_; }
+
+        void collect(ByteView path, ByteView rlp) {
+            if (!path.empty() && rlp.length() < kHashLength) {
+                return;  // embedded into its parent
+            }
+            for (size_t i{0}; i < paths_.size(); ++i) {
+                if (has_prefix(paths_[i], path)) {
+                    nodes_[i].emplace_back(path.length(), rlp);
+                }
+            }
+        }
+
+        // Nodes on the path to the i-th key, root first
+        std::vector<Bytes> proof(size_t i) {
+            auto& nodes{nodes_[i]};
+            std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            std::vector<Bytes> res;
+            for (auto& node : nodes) {
+                res.push_back(std::move(node.second));
+            }
+            return res;
+        }
+
+      private:
+        std::vector<Bytes> paths_;                                // unpacked
+        std::vector<std::vector<std::pair<size_t, Bytes>>> nodes_;  // (path length, RLP) per key
+    };
+
+}  // namespace
+
+/*
+ * Walks a single trie, alternating between subtries taken from intermediate hashes
+ * and leaves taken from the hashed state merged with the changes.
+ * A recorded branch node is reused only if none of the changed keys lies beneath it;
+ * otherwise it's erased and the walk descends into it.
+ * Likewise the walk descends down to the keys to be proven, if any.
+ */
+static evmc::bytes32 walk_trie(TrieSource& source, const std::map<Bytes, std::optional<Bytes>>& changes,
+                               ByteView storage_prefix, IntermediateHashUpdates* updates,
+                               ProofCollector* proofs = nullptr) {
+    std::vector<Bytes> changed_paths;
+    changed_paths.reserve(changes.size());
+    for (const auto& entry : changes) {
+        changed_paths.push_back(unpack_nibbles(entry.first));
+    }
+    if (proofs) {
+        changed_paths.insert(changed_paths.end(), proofs->paths().begin(), proofs->paths().end());
+        std::sort(changed_paths.begin(), changed_paths.end());
+    }
+
+    HashBuilder hb;
+    if (updates) {
+        hb.node_collector = [&](ByteView path, ByteView node_ref) {
+            if (!path.empty() && node_ref.length() == kHashLength) {
+                updates->put(storage_prefix, path, to_bytes32(node_ref));
+            }
+        };
+    }
+    if (proofs) {
+        hb.node_rlp_collector = [proofs](ByteView path, ByteView rlp) { proofs->collect(path, rlp); };
+    }
+
+    auto change{changes.begin()};
+
+    // Adds all leaves with keys in [from, to) in order
+    auto add_leaves = [&](ByteView from, const std::optional<Bytes>& to) {
+        auto in_range = [&to](ByteView key) { return !to || key_precedes_path(key, *to); };
+        auto leaf{source.seek_leaf(seek_key(from))};
+        while (true) {
+            bool has_leaf{leaf && in_range(leaf->first)};
+            bool has_change{change != changes.end() && in_range(change->first)};
+            if (!has_leaf && !has_change) {
+                break;
+            }
+            if (has_change && (!has_leaf || change->first <= leaf->first)) {
+                if (has_leaf && change->first == leaf->first) {
+                    leaf = source.next_leaf();
+                }
+                if (change->second) {
+                    hb.add(change->first, *change->second);
+                }
+                ++change;
+            } else {
+                hb.add(leaf->first, source.leaf_value(leaf->first, leaf->second));
+                leaf = source.next_leaf();
+            }
+        }
+    };
+
+    std::optional<Bytes> pos{Bytes{}};
+    while (pos) {
+        auto branch{source.seek_branch(*pos)};
+        while (branch && is_prefix_of_any(changed_paths, branch->first)) {
+            if (updates) {
+                updates->erase(storage_prefix, branch->first);
+            }
+            branch = source.next_branch();
+        }
+
+        if (!branch) {
+            add_leaves(*pos, std::nullopt);
+            break;
+        }
+
+        add_leaves(*pos, branch->first);
+        hb.add_branch_node(branch->first, branch->second);
+        pos = next_path(branch->first);
+    }
+
+    return hb.root_hash();
+}
+
+// Root of a storage trie without changes : the recorded one if any, otherwise walks the storage trie
+static evmc::bytes32 unchanged_storage_root(lmdb::Table& state, lmdb::Table& hashes, ByteView prefix,
+                                            IntermediateHashUpdates* updates) {
+    if (seek_storage_entry(hashes, prefix, {})) {
+        MDB_val key, data;
+        lmdb::err_handler(hashes.get_current(&key, &data));
+        return to_bytes32(db::from_mdb_val(data));
+    }
+    StorageTrieSource source{state, hashes, prefix};
+    evmc::bytes32 root{walk_trie(source, {}, prefix, updates)};
+    if (updates && root != kEmptyRoot) {
+        updates->put(prefix, {}, root);
+    }
+    return root;
+}
+
+evmc::bytes32 calculate_state_root(lmdb::Transaction& txn, const HashedStateChanges& changes,
+                                   IntermediateHashUpdates* updates) {
+    auto storage_state{txn.open(db::table::kCurrentState)};
+    auto storage_hashes{txn.open(db::table::kIntermediateTrieHash)};
+
+    // Storage roots : the recorded one if any, otherwise walk the storage trie
+    auto storage_root = [&](const evmc::bytes32& hashed_address, uint64_t incarnation) -> evmc::bytes32 {
+        if (!incarnation) {
+            return kEmptyRoot;
+        }
+        Bytes prefix{hashed_storage_prefix(hashed_address, incarnation)};
+        if (auto it{changes.storage.find(prefix)}; it == changes.storage.end()) {
+            return unchanged_storage_root(*storage_state, *storage_hashes, prefix, updates);
+        } else {
+            std::map<Bytes, std::optional<Bytes>> storage_changes;
+            Bytes rlp;
+            for (const auto& [location, value] : it->second) {
+                std::optional<Bytes>& leaf{storage_changes[Bytes{full_view(location)}]};
+                if (!is_zero(value)) {
+                    rlp.clear();
+                    rlp::encode(rlp, zeroless_view(value));
+                    leaf = rlp;
+                }
+            }
+            StorageTrieSource source{*storage_state, *storage_hashes, prefix};
+            evmc::bytes32 root{walk_trie(source, storage_changes, prefix, updates)};
+            if (updates) {
+                updates->erase(prefix, {});
+                if (root != kEmptyRoot) {
+                    updates->put(prefix, {}, root);
+                }
+            }
+            return root;
+        }
+    };
+
+    AccountTrieSource source{txn, storage_root};
+
+    // Accounts with changed storage are changed as well
+    std::map<Bytes, std::optional<Bytes>> account_changes;
+    for (const auto& [hashed_address, account] : changes.accounts) {
+        std::optional<Bytes>& leaf{account_changes[Bytes{full_view(hashed_address)}]};
+        if (account) {
+            Account copy{*account};
+            copy.storage_root = storage_root(hashed_address, copy.incarnation);
+            leaf.emplace();
+            rlp::encode(*leaf, copy);
+        }
+    }
+    for (const auto& entry : changes.storage) {
+        Bytes key{entry.first.substr(0, kHashLength)};
+        if (account_changes.count(key)) {
+            continue;
+        }
+        auto stored{storage_state->get(key)};
+        if (stored) {
+            account_changes[key] = source.leaf_value(key, *stored);
+        }
+    }
+
+    return walk_trie(source, account_changes, {}, updates);
+}
+
+void invalidate_intermediate_hashes(lmdb::Transaction& txn, const HashedStateChanges& changes) {
+    IntermediateHashUpdates updates;
+    auto erase_prefixes = [&updates](ByteView storage_prefix, ByteView key, size_t max_length) {
+        Bytes path{unpack_nibbles(key)};
+        for (size_t len{1}; len <= max_length; ++len) {
+            updates.erase(storage_prefix, path.substr(0, len));
+        }
+    };
+
+    for (const auto& entry : changes.accounts) {
+        erase_prefixes({}, full_view(entry.first), kMaxAccountPathLength);
+    }
+    for (const auto& [prefix, storage] : changes.storage) {
+        erase_prefixes({}, prefix.substr(0, kHashLength), kMaxAccountPathLength);
+        updates.erase(prefix, {});
+        for (const auto& entry : storage) {
+            erase_prefixes(prefix, full_view(entry.first), 2 * kHashLength - 1);
+        }
+    }
+
+    updates.write_to_db(txn);
+}
+
+AccountProof generate_proof(lmdb::Transaction& txn, const evmc::address& address,
+                            const std::vector<evmc::bytes32>& locations) {
+    auto state{txn.open(db::table::kCurrentState)};
+    auto hashes{txn.open(db::table::kIntermediateTrieHash)};
+
+    AccountProof res;
+    res.account = db::read_account(txn, address);
+    const uint64_t incarnation{res.account ? res.account->incarnation : 0};
+    const evmc::bytes32 hashed_address{to_bytes32(full_view(keccak256(full_view(address)).bytes))};
+
+    // Storage trie
+    std::vector<Bytes> hashed_locations;
+    for (const auto& location : locations) {
+        hashed_locations.emplace_back(full_view(keccak256(full_view(location)).bytes));
+    }
+    ProofCollector storage_proofs{hashed_locations};
+    evmc::bytes32 storage_root{kEmptyRoot};
+    if (incarnation) {
+        const Bytes prefix{hashed_storage_prefix(hashed_address, incarnation)};
+        StorageTrieSource source{*state, *hashes, prefix};
+        storage_root = walk_trie(source, {}, prefix, /*updates=*/nullptr, &storage_proofs);
+    }
+    for (size_t i{0}; i < locations.size(); ++i) {
+        evmc::bytes32 value{};
+        if (incarnation) {
+            value = db::read_storage(txn, address, incarnation, locations[i]);
+        }
+        res.storage.push_back({locations[i], value, storage_proofs.proof(i)});
+    }
+    if (res.account) {
+        res.account->storage_root = storage_root;
+    }
+
+    // Account trie
+    auto storage_root_of = [&](const evmc::bytes32& hashed, uint64_t inc) -> evmc::bytes32 {
+        if (!inc) {
+            return kEmptyRoot;
+        }
+        return unchanged_storage_root(*state, *hashes, hashed_storage_prefix(hashed, inc), /*updates=*/nullptr);
+    };
+    ProofCollector account_proof{{Bytes{full_view(hashed_address)}}};
+    AccountTrieSource source{txn, storage_root_of};
+    walk_trie(source, {}, {}, /*updates=*/nullptr, &account_proof);
+    res.proof = account_proof.proof(0);
+
+    return res;
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,119 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_INTERMEDIATE_HASHES_H_
+#define SILKWORM_TRIE_INTERMEDIATE_HASHES_H_
+
+/*
+Incremental computation of the state root out of the hashed state (table kCurrentState)
+and the intermediate hashes of the trie (table kIntermediateTrieHash).
+
+Layout of kCurrentState:
+ - accounts : hashed address (32 bytes) => account encoded for storage
+ - storage  : hashed address + incarnation (40 bytes) => hashed location (32 bytes) + zeroless value (dups)
+
+Layout of kIntermediateTrieHash:
+ - account trie : path of a branch node (one nibble per byte, shorter than 40 nibbles) => hash of the node
+ - storage trie : hashed address + incarnation (40 bytes) => path of a branch node + hash of the node (dups)
+                  The storage root itself is recorded as the dup with an empty path.
+
+Only branch nodes referenced by hash (i.e. with RLP at least 32 bytes long) are recorded.
+Each recorded intermediate hash is always up to date with the hashed state,
+so that any subtrie whose keys are left untouched by a change is taken as is.
+Missing intermediate hashes are just recomputed from the leaves below them.
+*/
+
+#include <map>
+#include <optional>
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/chaindb.hpp>
+#include <silkworm/types/account.hpp>
+#include <utility>
+#include <vector>
+
+namespace silkworm::trie {
+
+// Changes of the hashed state yet to be applied on top of kCurrentState
+struct HashedStateChanges {
+    // hashed address -> account (std::nullopt if deleted)
+    std::map<evmc::bytes32, std::optional<Account>> accounts;
+
+    // hashed storage prefix -> hashed location -> value (zero if deleted)
+    std::map<Bytes, std::map<evmc::bytes32, evmc::bytes32>> storage;
+};
+
+// Hashed address + incarnation (big endian)
+Bytes hashed_storage_prefix(const evmc::bytes32& hashed_address, uint64_t incarnation);
+
+// Changes of kIntermediateTrieHash resulting from a state root computation.
+// Paths are unpacked (one nibble per byte); an empty storage prefix denotes the account trie.
+class IntermediateHashUpdates {
+  public:
+    void put(ByteView storage_prefix, ByteView path, const evmc::bytes32& hash);
+
+    void erase(ByteView storage_prefix, ByteView path);
+
+    bool empty() const { return entries_.empty(); }
+
+    size_t size() const { return entries_.size(); }
+
+    void write_to_db(lmdb::Transaction& txn) const;
+
+  private:
+    // (storage prefix, path) -> hash (std::nullopt if erased)
+    std::map<std::pair<Bytes, Bytes>, std::optional<evmc::bytes32>> entries_;
+};
+
+/** @brief Calculates the state root hash of the hashed state with the given changes applied on top of it.
+ *
+ * Only the paths of the trie leading to changed keys are walked; every other subtrie is taken
+ * from kIntermediateTrieHash, hence the cost is proportional to the number of changes
+ * rather than to the size of the state. Nothing is written into the database:
+ * if updates is not null it receives the changes to kIntermediateTrieHash matching the new state.
+ */
+evmc::bytes32 calculate_state_root(lmdb::Transaction& txn, const HashedStateChanges& changes,
+                                   IntermediateHashUpdates* updates = nullptr);
+
+// Erases all the intermediate hashes affected by the given changes
+void invalidate_intermediate_hashes(lmdb::Transaction& txn, const HashedStateChanges& changes);
+
+// Merkle proof of a storage slot
+struct StorageProof {
+    evmc::bytes32 location;
+    evmc::bytes32 value;       // zero if the slot is empty
+    std::vector<Bytes> proof;  // RLP of the storage trie nodes on the path to the slot, root first
+};
+
+// Merkle proofs of an account and of some of its storage slots, as served by eth_getProof (EIP-1186)
+struct AccountProof {
+    std::optional<Account> account;  // with storage_root set; std::nullopt if there's no such account
+    std::vector<Bytes> proof;        // RLP of the account trie nodes on the path to the account, root first
+    std::vector<StorageProof> storage;
+};
+
+/** @brief Generates the Merkle proofs of an account and of the given storage slots of the current state.
+ *
+ * Values are read from kPlainState, while tries are walked out of kCurrentState and kIntermediateTrieHash
+ * descending only into the subtries on the paths to the requested keys.
+ * A proof stops at the node where the path to its key ends or diverges, so it also proves the absence of a key.
+ * As in eth_getProof only the root and the nodes referenced by hash are part of proofs.
+ */
+AccountProof generate_proof(lmdb::Transaction& txn, const evmc::address& address,
+                            const std::vector<evmc::bytes32>& locations);
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_INTERMEDIATE_HASHES_H_
@@ -0,0 +1,329 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "intermediate_hashes.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <catch2/catch.hpp>
+#include <silkworm/common/temp_dir.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/rlp/encode.hpp>
+#include <silkworm/state/memory_buffer.hpp>
+#include <silkworm/trie/hash_builder.hpp>
+
+namespace silkworm::trie {
+
+static evmc::address make_address(uint64_t i) {
+    evmc::address address{};
+    boost::endian::store_big_u64(&address.bytes[12], i * 0x9E3779B97F4A7C15ull);
+    return address;
+}
+
+static evmc::bytes32 make_location(uint64_t i) {
+    evmc::bytes32 location{};
+    boost::endian::store_big_u64(&location.bytes[24], i);
+    return location;
+}
+
+static evmc::bytes32 make_value(uint64_t i) {
+    evmc::bytes32 value{};
+    boost::endian::store_big_u64(&value.bytes[24], i * 7 + 1);
+    return value;
+}
+
+// Applies the same changes to both state buffers
+class DualBuffer {
+  public:
+    DualBuffer(db::Buffer& db_buffer, MemoryBuffer& memory_buffer) : db_{db_buffer}, memory_{memory_buffer} {}
+
+    void update_account(const evmc::address& address, std::optional<Account> initial, std::optional<Account> current) {
+        db_.update_account(address, initial, current);
+        memory_.update_account(address, initial, current);
+    }
+
+    void update_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location,
+                        const evmc::bytes32& initial, const evmc::bytes32& current) {
+        db_.update_storage(address, incarnation, location, initial, current);
+        memory_.update_storage(address, incarnation, location, initial, current);
+    }
+
+  private:
+    db::Buffer& db_;
+    MemoryBuffer& memory_;
+};
+
+TEST_CASE("Incremental state root") {
+    TemporaryDirectory tmp_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    MemoryBuffer expected;
+
+    constexpr uint64_t kNumAccounts{500};
+    constexpr uint64_t kNumContracts{20};
+    constexpr uint64_t kNumLocations{50};
+
+    // Initial state
+    {
+        db::Buffer buffer{txn.get()};
+        buffer.maintain_hashed_state(true);
+        DualBuffer state{buffer, expected};
+        for (uint64_t i{0}; i < kNumAccounts; ++i) {
+            Account account;
+            account.nonce = i;
+            account.balance = i * kEther;
+            if (i < kNumContracts) {
+                account.incarnation = db::kDefaultIncarnation;
+                account.code_hash = make_value(i);
+            }
+            state.update_account(make_address(i), std::nullopt, account);
+        }
+        for (uint64_t i{0}; i < kNumContracts; ++i) {
+            for (uint64_t j{0}; j < kNumLocations; ++j) {
+                state.update_storage(make_address(i), db::kDefaultIncarnation, make_location(j), {}, make_value(i + j));
+            }
+        }
+
+        CHECK(to_hex(buffer.state_root_hash()) == to_hex(expected.state_root_hash()));
+        buffer.write_to_db();
+    }
+
+    size_t num_hashes{0};
+    lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->get_rcount(&num_hashes));
+    CHECK(num_hashes > 0);
+
+    // Nothing changed : the root is made out of the recorded intermediate hashes only
+    CHECK(to_hex(calculate_state_root(*txn, {})) == to_hex(expected.state_root_hash()));
+
+    SECTION("Incremental changes") {
+        for (uint64_t round{0}; round < 3; ++round) {
+            db::Buffer buffer{txn.get()};
+            buffer.maintain_hashed_state(true);
+            DualBuffer state{buffer, expected};
+
+            // Modify, delete & create some accounts
+            for (uint64_t i{round}; i < kNumAccounts; i += 37) {
+                auto initial{expected.read_account(make_address(i))};
+                if (!initial) {
+                    continue;
+                }
+                Account current{*initial};
+                ++current.nonce;
+                state.update_account(make_address(i), initial, current);
+            }
+            const auto deleted{make_address(kNumContracts + round)};
+            state.update_account(deleted, expected.read_account(deleted), std::nullopt);
+            Account created;
+            created.balance = round + 1;
+            state.update_account(make_address(kNumAccounts + round), std::nullopt, created);
+
+            // Modify, delete & create some storage
+            const auto contract{make_address(round)};
+            auto initial{expected.read_storage(contract, db::kDefaultIncarnation, make_location(0))};
+            state.update_storage(contract, db::kDefaultIncarnation, make_location(0), initial,
+                                 make_value(1000 + round));
+            initial = expected.read_storage(contract, db::kDefaultIncarnation, make_location(1 + round));
+            state.update_storage(contract, db::kDefaultIncarnation, make_location(1 + round), initial, {});
+            state.update_storage(contract, db::kDefaultIncarnation, make_location(kNumLocations + round), {},
+                                 make_value(round));
+
+            CHECK(to_hex(buffer.state_root_hash()) == to_hex(expected.state_root_hash()));
+            buffer.write_to_db();
+
+            // Intermediate hashes are consistent with the new state
+            CHECK(to_hex(calculate_state_root(*txn, {})) == to_hex(expected.state_root_hash()));
+        }
+    }
+
+    SECTION("Changes written without state root") {
+        {
+            db::Buffer buffer{txn.get()};
+            buffer.maintain_hashed_state(true);
+            DualBuffer state{buffer, expected};
+            for (uint64_t i{0}; i < kNumAccounts; i += 11) {
+                auto initial{expected.read_account(make_address(i))};
+                Account current{*initial};
+                current.balance += 1;
+                state.update_account(make_address(i), initial, current);
+            }
+            const auto contract{make_address(kNumContracts - 1)};
+            for (uint64_t j{0}; j < kNumLocations; j += 3) {
+                auto initial{expected.read_storage(contract, db::kDefaultIncarnation, make_location(j))};
+                state.update_storage(contract, db::kDefaultIncarnation, make_location(j), initial, make_value(2 * j));
+            }
+            buffer.write_to_db();
+        }
+
+        lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->get_rcount(&num_hashes));
+        CHECK(num_hashes > 0);
+        CHECK(to_hex(calculate_state_root(*txn, {})) == to_hex(expected.state_root_hash()));
+    }
+
+    SECTION("Without intermediate hashes") {
+        lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->clear());
+
+        IntermediateHashUpdates updates;
+        CHECK(to_hex(calculate_state_root(*txn, {}, &updates)) == to_hex(expected.state_root_hash()));
+        CHECK(updates.size() > 0);
+
+        updates.write_to_db(*txn);
+        lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->get_rcount(&num_hashes));
+        CHECK(num_hashes == updates.size());
+        CHECK(to_hex(calculate_state_root(*txn, {})) == to_hex(expected.state_root_hash()));
+    }
+}
+
+TEST_CASE("Hashed state maintenance is opt-in") {
+    TemporaryDirectory tmp_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    db::Buffer buffer{txn.get()};
+    Account account;
+    account.balance = kEther;
+    buffer.update_account(make_address(1), std::nullopt, account);
+    buffer.update_storage(make_address(1), db::kDefaultIncarnation, make_location(1), {}, make_value(1));
+    CHECK_THROWS(buffer.state_root_hash());
+    buffer.write_to_db();
+
+    size_t count{0};
+    lmdb::err_handler(txn->open(db::table::kPlainState)->get_rcount(&count));
+    CHECK(count == 2);
+    lmdb::err_handler(txn->open(db::table::kCurrentState)->get_rcount(&count));
+    CHECK(count == 0);
+    lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->get_rcount(&count));
+    CHECK(count == 0);
+}
+
+// Checks that the proof nodes hash up to the root, each one referenced by hash from the one above it,
+// and that the last one holds the given leaf value (if any)
+static void check_proof(const std::vector<Bytes>& proof, const evmc::bytes32& root, std::optional<Bytes> leaf_value) {
+    REQUIRE(!proof.empty());
+    CHECK(to_hex(full_view(keccak256(proof[0]).bytes)) == to_hex(root));
+    for (size_t i{1}; i < proof.size(); ++i) {
+        const ethash::hash256 hash{keccak256(proof[i])};
+        CHECK(proof[i - 1].find(full_view(hash.bytes)) != Bytes::npos);
+    }
+    if (leaf_value) {
+        CHECK(proof.back().find(*leaf_value) != Bytes::npos);
+    }
+}
+
+TEST_CASE("Merkle proofs") {
+    TemporaryDirectory tmp_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    MemoryBuffer expected;
+
+    constexpr uint64_t kNumAccounts{300};
+    constexpr uint64_t kNumLocations{100};
+    const evmc::address contract{make_address(0)};
+    {
+        db::Buffer buffer{txn.get()};
+        buffer.maintain_hashed_state(true);
+        DualBuffer state{buffer, expected};
+        for (uint64_t i{0}; i < kNumAccounts; ++i) {
+            Account account;
+            account.balance = i + 1;
+            if (i == 0) {
+                account.incarnation = db::kDefaultIncarnation;
+                account.code_hash = make_value(i);
+            }
+            state.update_account(make_address(i), std::nullopt, account);
+        }
+        for (uint64_t j{0}; j < kNumLocations; ++j) {
+            state.update_storage(contract, db::kDefaultIncarnation, make_location(j), {}, make_value(j));
+        }
+        buffer.state_root_hash();
+        buffer.write_to_db();
+    }
+    const evmc::bytes32 state_root{expected.state_root_hash()};
+
+    std::map<evmc::bytes32, Bytes> storage_leaves;
+    for (uint64_t j{0}; j < kNumLocations; ++j) {
+        Bytes& value_rlp{storage_leaves[to_bytes32(full_view(keccak256(full_view(make_location(j))).bytes))]};
+        rlp::encode(value_rlp, zeroless_view(make_value(j)));
+    }
+    HashBuilder hb;
+    for (const auto& [key, value] : storage_leaves) {
+        hb.add(full_view(key), value);
+    }
+    const evmc::bytes32 storage_root{hb.root_hash()};
+
+    SECTION("Existing account & slots") {
+        const std::vector<evmc::bytes32> locations{make_location(3), make_location(kNumLocations - 1)};
+        AccountProof res{generate_proof(*txn, contract, locations)};
+
+        REQUIRE(res.account);
+        CHECK(res.account->balance == 1);
+        CHECK(to_hex(res.account->storage_root) == to_hex(storage_root));
+        Bytes account_rlp;
+        rlp::encode(account_rlp, *res.account);
+        CHECK(res.proof.size() > 1);
+        check_proof(res.proof, state_root, account_rlp);
+
+        REQUIRE(res.storage.size() == 2);
+        for (size_t i{0}; i < locations.size(); ++i) {
+            CHECK(res.storage[i].location == locations[i]);
+            CHECK(res.storage[i].value == expected.read_storage(contract, db::kDefaultIncarnation, locations[i]));
+            Bytes value_rlp;
+            rlp::encode(value_rlp, zeroless_view(res.storage[i].value));
+            check_proof(res.storage[i].proof, storage_root, value_rlp);
+        }
+
+        // Same proofs without intermediate hashes
+        lmdb::err_handler(txn->open(db::table::kIntermediateTrieHash)->clear());
+        AccountProof res2{generate_proof(*txn, contract, locations)};
+        CHECK(res2.proof == res.proof);
+        REQUIRE(res2.storage.size() == 2);
+        CHECK(res2.storage[0].proof == res.storage[0].proof);
+        CHECK(res2.storage[1].proof == res.storage[1].proof);
+    }
+
+    SECTION("Missing account & slot") {
+        AccountProof res{generate_proof(*txn, make_address(kNumAccounts), {})};
+        CHECK(!res.account);
+        check_proof(res.proof, state_root, std::nullopt);
+        CHECK(res.storage.empty());
+
+        res = generate_proof(*txn, contract, {make_location(kNumLocations)});
+        REQUIRE(res.storage.size() == 1);
+        CHECK(is_zero(res.storage[0].value));
+        check_proof(res.storage[0].proof, storage_root, std::nullopt);
+    }
+
+    SECTION("Account without storage") {
+        AccountProof res{generate_proof(*txn, make_address(1), {make_location(0)})};
+        REQUIRE(res.account);
+        CHECK(res.account->storage_root == kEmptyRoot);
+        REQUIRE(res.storage.size() == 1);
+        CHECK(res.storage[0].proof.empty());
+    }
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,66 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_root.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <optional>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/db/util.hpp>
+#include <silkworm/trie/state_root_builder.hpp>
+#include <utility>
+
+namespace silkworm::trie {
+
+evmc::bytes32 scan_state_root(lmdb::Transaction& txn) {
+    auto table{txn.open(db::table::kCurrentState)};
+    StateRootBuilder builder;
+
+    // Hashed address & incarnation of the account last added, whose storage is expected next
+    std::optional<std::pair<evmc::bytes32, uint64_t>> current;
+
+    MDB_val key, data;
+    int rc{table->get_first(&key, &data)};
+    for (; !rc; rc = table->get_next(&key, &data)) {
+        ByteView k{db::from_mdb_val(key)};
+        ByteView v{db::from_mdb_val(data)};
+
+        if (k.length() == kHashLength) {
+            auto [account, err]{decode_account_from_storage(v)};
+            if (err != rlp::DecodingResult::kOk) {
+                throw err;
+            }
+            const evmc::bytes32 hashed_address{to_bytes32(k)};
+            builder.add_account(hashed_address, account);
+            current.emplace(hashed_address, account.incarnation);
+        } else if (k.length() == kHashLength + db::kIncarnationLength && v.length() > kHashLength) {
+            if (!current || std::memcmp(k.data(), current->first.bytes, kHashLength) != 0 ||
+                boost::endian::load_big_u64(&k[kHashLength]) != current->second) {
+                continue;
+            }
+            builder.add_storage(to_bytes32(v.substr(0, kHashLength)), to_bytes32(v.substr(kHashLength)));
+        }
+    }
+    if (rc != MDB_NOTFOUND) {
+        lmdb::err_handler(rc);
+    }
+
+    return builder.root_hash();
+}
+
+}  // namespace silkworm::trie
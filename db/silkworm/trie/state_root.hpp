@@ -0,0 +1,36 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#ifndef SILKWORM_TRIE_STATE_ROOT_H_
+#define SILKWORM_TRIE_STATE_ROOT_H_
+
+#include <silkworm/common/base.hpp>
+#include <silkworm/db/chaindb.hpp>
+
+namespace silkworm::trie {
+
+/** @brief Calculates the state root out of kCurrentState alone, scanning it once in key order.
+ *
+ * Unlike calculate_state_root, kIntermediateTrieHash is neither read nor written,
+ * which makes it fit for verifying a state imported from a snapshot or generated for a test chain.
+ * Memory use doesn't depend on the size of the state (see StateRootBuilder).
+ * Storage left behind by previous incarnations or deleted accounts is skipped.
+ */
+evmc::bytes32 scan_state_root(lmdb::Transaction& txn);
+
+}  // namespace silkworm::trie
+
+#endif  // SILKWORM_TRIE_STATE_ROOT_H_
@@ -0,0 +1,83 @@
+/*
+   Copyright 2021 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_root.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <catch2/catch.hpp>
+#include <silkworm/common/temp_dir.hpp>
+#include <silkworm/common/util.hpp>
+#include <silkworm/db/buffer.hpp>
+#include <silkworm/db/tables.hpp>
+#include <silkworm/state/memory_buffer.hpp>
+#include <silkworm/trie/intermediate_hashes.hpp>
+
+namespace silkworm::trie {
+
+TEST_CASE("Scan state root") {
+    TemporaryDirectory tmp_dir;
+    lmdb::DatabaseConfig db_config{tmp_dir.path(), 32 * kMebi};
+    db_config.set_readonly(false);
+    auto env{lmdb::get_env(db_config)};
+    auto txn{env->begin_rw_transaction()};
+    db::table::create_all(*txn);
+
+    CHECK(scan_state_root(*txn) == kEmptyRoot);
+
+    MemoryBuffer expected;
+    {
+        db::Buffer buffer{txn.get()};
+        buffer.maintain_hashed_state(true);
+        for (uint64_t i{0}; i < 200; ++i) {
+            evmc::address address{};
+            boost::endian::store_big_u64(&address.bytes[12], i * 0x9E3779B97F4A7C15ull);
+            Account account;
+            account.balance = i + 1;
+            if (i % 20 == 0) {
+                account.incarnation = db::kDefaultIncarnation;
+                for (uint64_t j{0}; j < i + 1; ++j) {
+                    evmc::bytes32 location{};
+                    boost::endian::store_big_u64(&location.bytes[24], j);
+                    evmc::bytes32 value{};
+                    boost::endian::store_big_u64(&value.bytes[24], j + 1);
+                    buffer.update_storage(address, db::kDefaultIncarnation, location, {}, value);
+                    expected.update_storage(address, db::kDefaultIncarnation, location, {}, value);
+                }
+            }
+            buffer.update_account(address, std::nullopt, account);
+            expected.update_account(address, std::nullopt, account);
+        }
+        buffer.write_to_db();
+    }
+    const evmc::bytes32 root{expected.state_root_hash()};
+    CHECK(to_hex(scan_state_root(*txn)) == to_hex(root));
+
+    // Leftovers of a previous incarnation and of a deleted account don't count
+    auto table{txn->open(db::table::kCurrentState)};
+    Bytes slot(kHashLength, '\0');
+    slot.push_back(0x01);
+    MDB_val key, data;
+    REQUIRE(!table->get_first(&key, &data));
+    const evmc::bytes32 first_hashed_address{to_bytes32(db::from_mdb_val(key))};
+    table->put(hashed_storage_prefix(first_hashed_address, db::kDefaultIncarnation + 1), slot);
+    table->put(hashed_storage_prefix(evmc::bytes32{}, db::kDefaultIncarnation), slot);
+    CHECK(to_hex(scan_state_root(*txn)) == to_hex(root));
+
+    // Same as the root out of the intermediate hashes
+    CHECK(to_hex(calculate_state_root(*txn, {})) == to_hex(root));
+}
+
+}  // namespace silkworm::trie
@@ -20,6 +20,7 @@
 #include <silkworm/chain/difficulty.hpp>
 #include <silkworm/common/util.hpp>
 #include <silkworm/execution/processor.hpp>
+#include <silkworm/types/sender_cache.hpp>
 
 void* new_buffer(size_t size) { return std::malloc(size); }
 
@@ -174,8 +175,18 @@ uint64_t header_number(const BlockHeader* header) { return header->number; }
 
 uint8_t* header_state_root(BlockHeader* header) { return header->state_root.bytes; }
 
+SenderCache* new_sender_cache(size_t max_size) { return new SenderCache{max_size}; }
+
+void delete_sender_cache(SenderCache* x) { delete x; }
+
+uint64_t sender_cache_hits(const SenderCache* cache) { return cache->hits(); }
+
 void block_recover_senders(Block* b, const ChainConfig* config) { b->recover_senders(*config); }
 
+void block_recover_senders_cached(Block* b, const ChainConfig* config, SenderCache* cache) {
+    b->recover_senders(*config, cache);
+}
+
 MemoryBuffer* new_state() { return new MemoryBuffer; }
 
 void delete_state(MemoryBuffer* x) { delete x; }
@@ -246,6 +257,8 @@ Blockchain* new_blockchain(StateBuffer* state, const ChainConfig* config, const
 
 void delete_blockchain(Blockchain* x) { delete x; }
 
+void blockchain_set_sender_cache(Blockchain* chain, SenderCache* cache) { chain->sender_cache = cache; }
+
 ValidationResult blockchain_insert_block(Blockchain* chain, Block* block, bool check_state_root) {
     return chain->insert_block(*block, check_state_root);
 }
@@ -93,8 +93,18 @@ SILKWORM_EXPORT uint64_t header_number(const silkworm::BlockHeader* header);
 
 SILKWORM_EXPORT uint8_t* header_state_root(silkworm::BlockHeader* header);
 
+SILKWORM_EXPORT silkworm::SenderCache* new_sender_cache(size_t max_size);
+SILKWORM_EXPORT void delete_sender_cache(silkworm::SenderCache* x);
+
+// Number of sender recoveries avoided thanks to the cache
+SILKWORM_EXPORT uint64_t sender_cache_hits(const silkworm::SenderCache* cache);
+
 SILKWORM_EXPORT void block_recover_senders(silkworm::Block* b, const silkworm::ChainConfig* config);
 
+// Same as block_recover_senders, looking senders up in & adding them to the cache
+SILKWORM_EXPORT void block_recover_senders_cached(silkworm::Block* b, const silkworm::ChainConfig* config,
+                                                  silkworm::SenderCache* cache);
+
 SILKWORM_EXPORT silkworm::MemoryBuffer* new_state();
 SILKWORM_EXPORT void delete_state(silkworm::MemoryBuffer* x);
 
@@ -131,6 +141,9 @@ SILKWORM_EXPORT silkworm::Blockchain* new_blockchain(silkworm::StateBuffer* stat
                                                      const silkworm::Block* genesis_block);
 SILKWORM_EXPORT void delete_blockchain(silkworm::Blockchain* x);
 
+// cache may be null
+SILKWORM_EXPORT void blockchain_set_sender_cache(silkworm::Blockchain* chain, silkworm::SenderCache* cache);
+
 SILKWORM_EXPORT silkworm::ValidationResult blockchain_insert_block(silkworm::Blockchain* chain, silkworm::Block* block,
                                                                    bool check_state_root);
 }